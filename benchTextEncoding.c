@@ -0,0 +1,719 @@
+//usr/bin/clang -O2 "$0" && exec ./a.out "$@"
+
+/*
+  Microbenchmark and regression harness for the text / encoding snippets.
+
+  Unlike the other snippets this one builds with -O2 when run as a script, so
+  the numbers mean something. Every case runs over a fixed, seeded corpus, one
+  "unit" (e.g. 1 KiB of input, 64 values, one help table) per timed call:
+
+  ```
+  ./benchTextEncoding.c                          Run every case and print a table
+  ./benchTextEncoding.c --filter hex             Only cases with "hex" in the name
+  ./benchTextEncoding.c --hist                   Also print latency histograms
+  ./benchTextEncoding.c --save base.txt          Write the results as a baseline
+  ./benchTextEncoding.c --compare base.txt       Exit 1 if any case is >10% slower (or missing)
+  ./benchTextEncoding.c --compare base.txt --threshold 5
+  ```
+
+  Reported per case: throughput (MB/s, best of BENCH_RUNS), ticks per byte and
+  p50 / p99 ticks per unit. Ticks come from the cycle counter where there is
+  one (x86 rdtsc, which counts at a fixed reference rate; ARMv8 cntvct_el0),
+  otherwise nanoseconds from clock_gettime(). Compare baselines only against
+  runs on the same machine.
+
+  Baseline file: one case per line, '#' starts a comment
+    <name> <MB/s> <ticks/byte> <p50 ticks> <p99 ticks>
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* The snippets under test, without their demo/test/bench mains */
+#pragma push_macro("DEMO")
+#pragma push_macro("TEST")
+#pragma push_macro("BENCH")
+#undef DEMO
+#undef TEST
+#undef BENCH
+#include "minstrhex.c"
+#include "genhelpstr.c"
+#include "datauriBase64EncodeBufferless.c"
+#include "cobsSlipFraming.c"
+#pragma pop_macro("BENCH")
+#pragma pop_macro("TEST")
+#pragma pop_macro("DEMO")
+
+#define BENCH_RUNS        3      ///< Best of, per case
+#define BENCH_MIN_SAMPLES 1000   ///< Timed units per run (at least)
+#define BENCH_MIN_SECONDS 0.05   ///< Time per run (at least)
+#define BENCH_MAX_SAMPLES 200000
+#define BENCH_HIST_WIDTH  40
+#define BENCH_NAME_MAX    64
+
+
+/*******************************************************************************
+ * Timing
+*******************************************************************************/
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_TICKS_NAME "tsc"
+static inline uint64_t bench_ticks(void)
+{
+  return __rdtsc();
+}
+#elif defined(__aarch64__)
+#define BENCH_TICKS_NAME "cntvct"
+static inline uint64_t bench_ticks(void)
+{
+  uint64_t t;
+  __asm__ volatile("isb; mrs %0, cntvct_el0" : "=r"(t));
+  return t;
+}
+#else
+#define BENCH_TICKS_NAME "ns"
+static inline uint64_t bench_ticks(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+static double bench_seconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static volatile uint32_t bench_sink; ///< Results are folded in here so nothing is optimised away
+
+
+/*******************************************************************************
+ * Fixed Corpora (Seeded, so every run sees the same bytes)
+*******************************************************************************/
+
+#define CORPUS_BYTES      (64u * 1024u)
+#define CORPUS_UNIT_BYTES 1024u
+#define CORPUS_UNITS      (CORPUS_BYTES / CORPUS_UNIT_BYTES)
+#define CORPUS_VALUES     4096u
+#define CORPUS_UNIT_VALUES 64u
+#define CORPUS_URI_BYTES  4096u
+#define CORPUS_FRAME_BYTES 256u
+
+static uint8_t corpus_bytes[CORPUS_BYTES];         ///< Random binary
+static uint8_t corpus_text[CORPUS_BYTES];          ///< Log like text (compressible)
+static char corpus_hex[CORPUS_BYTES * 2];          ///< corpus_bytes as hex
+static uint32_t corpus_u32[CORPUS_VALUES];         ///< Mixed magnitude counters
+static char corpus_dec[CORPUS_VALUES][12];         ///< corpus_u32 as decimal
+static uint8_t corpus_dec_len[CORPUS_VALUES];
+static int32_t corpus_q16[CORPUS_VALUES];          ///< Q16.16 readings
+static float corpus_f32[CORPUS_VALUES];            ///< Float readings
+static char corpus_uri_base64[CORPUS_URI_BYTES * 2];
+static char corpus_uri_lzss[CORPUS_URI_BYTES * 2];
+
+static const char *corpus_help[][2] = {
+  {"write",  "... <addr> <value>: Write a value to a register\r\n...  -v <addr> <value>: Write then read back\r\n"},
+  {"read",   "... <addr>: Read a register\r\n"},
+  {"dump",   "... <addr> <len>: Hexdump memory\r\n...  -c: Canonical hex+ASCII display\r\n"},
+  {"reset",  "... : Reset the device\r\n"},
+  {"log",    "... [level]: Show or set the log level\r\n"},
+  {"sensor", "... <ch>: Read a sensor channel\r\n...  all: Read every channel\r\n"},
+  {"uri",    "... <addr> <len>: Export memory as a data uri\r\n"},
+  {"help",   "... : Lists all the registered commands\r\n"},
+};
+#define CORPUS_HELP_COUNT (sizeof(corpus_help) / sizeof(corpus_help[0]))
+
+static uint32_t corpus_rand(void)
+{
+  static uint32_t x = 2463534242u;
+  x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+  return x;
+}
+
+static char *uri_capture;
+static size_t uri_capture_len;
+static int uri_capture_putchar(int c)
+{
+  uri_capture[uri_capture_len++] = (char)c;
+  return c;
+}
+
+static void corpus_init(void)
+{
+  for (size_t i = 0 ; i < CORPUS_BYTES ; i++)
+    corpus_bytes[i] = (uint8_t)corpus_rand();
+  append_hex_block(corpus_hex, corpus_bytes, CORPUS_BYTES);
+
+  minstr_t sb;
+  minstr_init(&sb, (char *)corpus_text, sizeof(corpus_text));
+  for (uint32_t i = 0 ; minstr_room(&sb) > 0 ; i++)
+    MINSTR_FMT(&sb, MINSTR_S("sensor ch="), MINSTR_U32(i % 8), MINSTR_S(" temp="), MINSTR_FIX((int32_t)(corpus_rand() % (40u << 16)), 16, 2), MINSTR_S("\r\n"));
+
+  for (size_t i = 0 ; i < CORPUS_VALUES ; i++)
+  {
+    const uint32_t r = corpus_rand();
+    corpus_u32[i] = r >> (r % 31);
+    corpus_dec_len[i] = (uint8_t)(append_uint32(corpus_dec[i], corpus_u32[i]) - corpus_dec[i]);
+    corpus_q16[i] = (int32_t)(corpus_rand() % (200u << 16)) - (100 << 16);
+    corpus_f32[i] = (float)corpus_q16[i] / 65536.0f;
+  }
+
+  uri_capture = corpus_uri_base64;
+  uri_capture_len = 0;
+  datauriEncodeBufferless(uri_capture_putchar, "application/octet-stream", corpus_bytes, CORPUS_URI_BYTES, DATAURI_ENCODING_BASE64);
+  uri_capture = corpus_uri_lzss;
+  uri_capture_len = 0;
+  datauriEncodeBufferless(uri_capture_putchar, "text/plain", corpus_text, CORPUS_URI_BYTES, DATAURI_FLAG_LZSS | DATAURI_FLAG_CRC32);
+}
+
+
+/*******************************************************************************
+ * Cases (Each call processes one unit and returns the input bytes it covered)
+*******************************************************************************/
+
+static size_t case_hex_append_loop(size_t unit)
+{
+  static char out[CORPUS_UNIT_BYTES * 2];
+  const uint8_t *in = &corpus_bytes[(unit % CORPUS_UNITS) * CORPUS_UNIT_BYTES];
+  char *p = out;
+  for (size_t i = 0 ; i < CORPUS_UNIT_BYTES ; i++)
+    p = append_hex(p, (char)in[i]);
+  bench_sink ^= (uint8_t)out[unit % sizeof(out)];
+  return CORPUS_UNIT_BYTES;
+}
+
+static size_t case_hex_append_block(size_t unit)
+{
+  static char out[CORPUS_UNIT_BYTES * 2];
+  append_hex_block(out, &corpus_bytes[(unit % CORPUS_UNITS) * CORPUS_UNIT_BYTES], CORPUS_UNIT_BYTES);
+  bench_sink ^= (uint8_t)out[unit % sizeof(out)];
+  return CORPUS_UNIT_BYTES;
+}
+
+static size_t case_hex_parse_block(size_t unit)
+{
+  static uint8_t out[CORPUS_UNIT_BYTES];
+  size_t errorPos = 0;
+  parse_hex_block(&corpus_hex[(unit % CORPUS_UNITS) * CORPUS_UNIT_BYTES * 2], CORPUS_UNIT_BYTES * 2, out, &errorPos);
+  bench_sink ^= out[unit % sizeof(out)];
+  return CORPUS_UNIT_BYTES * 2;
+}
+
+static size_t case_hexdump(size_t unit)
+{
+  static char out[(CORPUS_UNIT_BYTES / HEXDUMP_BYTES_PER_LINE + 2) * (HEXDUMP_LINE_MAX + 1)];
+  minstr_t sb = minstr_struct_prefill(out);
+  minstr_append_hexdump(&sb, &corpus_bytes[(unit % CORPUS_UNITS) * CORPUS_UNIT_BYTES], CORPUS_UNIT_BYTES, 0);
+  bench_sink ^= (uint32_t)minstr_length(&sb);
+  return CORPUS_UNIT_BYTES;
+}
+
+static size_t case_dec_snprintf(size_t unit)
+{
+  static char out[CORPUS_UNIT_VALUES * 12];
+  const size_t base = (unit * CORPUS_UNIT_VALUES) % CORPUS_VALUES;
+  char *p = out;
+  for (size_t i = 0 ; i < CORPUS_UNIT_VALUES ; i++)
+    p += snprintf(p, 12, "%u", (unsigned)corpus_u32[base + i]);
+  bench_sink ^= (uint32_t)(p - out);
+  return (size_t)(p - out);
+}
+
+static size_t case_dec_append_uint32(size_t unit)
+{
+  static char out[CORPUS_UNIT_VALUES * 12];
+  const size_t base = (unit * CORPUS_UNIT_VALUES) % CORPUS_VALUES;
+  char *p = out;
+  for (size_t i = 0 ; i < CORPUS_UNIT_VALUES ; i++)
+    p = append_uint32(p, corpus_u32[base + i]);
+  bench_sink ^= (uint32_t)(p - out);
+  return (size_t)(p - out);
+}
+
+static size_t case_dec_strtoul(size_t unit)
+{
+  const size_t base = (unit * CORPUS_UNIT_VALUES) % CORPUS_VALUES;
+  size_t bytes = 0;
+  uint32_t sum = 0;
+  for (size_t i = 0 ; i < CORPUS_UNIT_VALUES ; i++)
+  {
+    sum += (uint32_t)strtoul(corpus_dec[base + i], NULL, 10);
+    bytes += corpus_dec_len[base + i];
+  }
+  bench_sink ^= sum;
+  return bytes;
+}
+
+static size_t case_dec_parse_uint32(size_t unit)
+{
+  const size_t base = (unit * CORPUS_UNIT_VALUES) % CORPUS_VALUES;
+  size_t bytes = 0;
+  uint32_t sum = 0;
+  size_t errorPos = 0;
+  for (size_t i = 0 ; i < CORPUS_UNIT_VALUES ; i++)
+  {
+    uint32_t val = 0;
+    parse_uint32(corpus_dec[base + i], corpus_dec_len[base + i], &val, &errorPos);
+    sum += val;
+    bytes += corpus_dec_len[base + i];
+  }
+  bench_sink ^= sum;
+  return bytes;
+}
+
+static size_t case_fixed_snprintf(size_t unit)
+{
+  static char out[CORPUS_UNIT_VALUES * 24];
+  const size_t base = (unit * CORPUS_UNIT_VALUES) % CORPUS_VALUES;
+  char *p = out;
+  for (size_t i = 0 ; i < CORPUS_UNIT_VALUES ; i++)
+    p += snprintf(p, 24, "%.4f", (double)corpus_q16[base + i] / 65536.0);
+  bench_sink ^= (uint32_t)(p - out);
+  return (size_t)(p - out);
+}
+
+static size_t case_fixed_append(size_t unit)
+{
+  static char out[CORPUS_UNIT_VALUES * 24];
+  const size_t base = (unit * CORPUS_UNIT_VALUES) % CORPUS_VALUES;
+  char *p = out;
+  for (size_t i = 0 ; i < CORPUS_UNIT_VALUES ; i++)
+    p = append_fixed(p, corpus_q16[base + i], 16, 4);
+  bench_sink ^= (uint32_t)(p - out);
+  return (size_t)(p - out);
+}
+
+static size_t case_float_snprintf(size_t unit)
+{
+  static char out[CORPUS_UNIT_VALUES * 24];
+  const size_t base = (unit * CORPUS_UNIT_VALUES) % CORPUS_VALUES;
+  char *p = out;
+  for (size_t i = 0 ; i < CORPUS_UNIT_VALUES ; i++)
+    p += snprintf(p, 24, "%.9g", (double)corpus_f32[base + i]);
+  bench_sink ^= (uint32_t)(p - out);
+  return (size_t)(p - out);
+}
+
+static size_t case_float_append(size_t unit)
+{
+  static char out[CORPUS_UNIT_VALUES * 24];
+  const size_t base = (unit * CORPUS_UNIT_VALUES) % CORPUS_VALUES;
+  char *p = out;
+  for (size_t i = 0 ; i < CORPUS_UNIT_VALUES ; i++)
+    p = append_float(p, corpus_f32[base + i]);
+  bench_sink ^= (uint32_t)(p - out);
+  return (size_t)(p - out);
+}
+
+static size_t case_help_gen(size_t unit)
+{
+  static char out[512];
+  size_t bytes = 0;
+  (void)unit;
+  for (size_t i = 0 ; i < CORPUS_HELP_COUNT ; i++)
+  {
+    gen_help_str(out, sizeof(out), corpus_help[i][0], corpus_help[i][1], 4, 8);
+    bytes += strlen(out);
+  }
+  bench_sink ^= (uint32_t)bytes;
+  return bytes;
+}
+
+static size_t case_help_resumable(size_t unit)
+{
+  static char out[64]; ///< Small write buffer, like FreeRTOS CLI
+  size_t bytes = 0;
+  (void)unit;
+  for (size_t i = 0 ; i < CORPUS_HELP_COUNT ; i++)
+  {
+    gen_help_cursor_t cursor;
+    gen_help_cursor_init(&cursor, corpus_help[i][1]);
+    while (!gen_help_cursor_done(&cursor))
+      bytes += gen_help_str_resumable(out, sizeof(out), &cursor, corpus_help[i][0], 4, 8);
+  }
+  bench_sink ^= (uint32_t)bytes;
+  return bytes;
+}
+
+static size_t case_help_table_copy(size_t unit)
+{
+  static char arena[2048];
+  static help_table_entry_t entries[CORPUS_HELP_COUNT];
+  static help_table_t table;
+  static char out[512];
+  size_t bytes = 0;
+  (void)unit;
+  if (help_table_is_stale(&table, 1))
+  { /* Built once (during warm up), the steady state is what this case measures */
+    help_table_init(&table, arena, sizeof(arena), entries, CORPUS_HELP_COUNT, 4, 8);
+    help_table_begin(&table);
+    for (size_t i = 0 ; i < CORPUS_HELP_COUNT ; i++)
+      help_table_add(&table, corpus_help[i][0], corpus_help[i][1]);
+    help_table_end(&table, 1);
+  }
+  for (size_t i = 0 ; i < help_table_count(&table) ; i++)
+    bytes += help_table_copy(&table, i, out, sizeof(out));
+  bench_sink ^= (uint32_t)bytes;
+  return bytes;
+}
+
+static size_t bench_datauri_encode(size_t unit, const uint8_t *corpus, uint32_t flags)
+{
+  static char out[CORPUS_URI_BYTES * 2];
+  const size_t offset = (unit % (CORPUS_BYTES / CORPUS_URI_BYTES)) * CORPUS_URI_BYTES;
+  uri_capture = out;
+  uri_capture_len = 0;
+  datauriEncodeBufferless(uri_capture_putchar, "application/octet-stream", &corpus[offset], CORPUS_URI_BYTES, flags);
+  bench_sink ^= (uint32_t)uri_capture_len;
+  return CORPUS_URI_BYTES;
+}
+
+static size_t case_datauri_base64_encode(size_t unit)
+{
+  return bench_datauri_encode(unit, corpus_bytes, DATAURI_ENCODING_BASE64);
+}
+
+static size_t case_datauri_z85_encode(size_t unit)
+{
+  return bench_datauri_encode(unit, corpus_bytes, DATAURI_ENCODING_Z85);
+}
+
+static size_t case_datauri_base64_crc_encode(size_t unit)
+{
+  return bench_datauri_encode(unit, corpus_bytes, DATAURI_ENCODING_BASE64 | DATAURI_FLAG_CRC32);
+}
+
+static size_t case_datauri_lzss_encode(size_t unit)
+{
+  return bench_datauri_encode(unit, corpus_text, DATAURI_ENCODING_BASE64 | DATAURI_FLAG_LZSS);
+}
+
+static size_t case_datauri_base64_decode(size_t unit)
+{
+  static uint8_t out[CORPUS_URI_BYTES];
+  size_t outLength = 0;
+  (void)unit;
+  datauriDecode(corpus_uri_base64, out, sizeof(out), &outLength);
+  bench_sink ^= (uint32_t)outLength;
+  return CORPUS_URI_BYTES;
+}
+
+static size_t case_datauri_lzss_decode(size_t unit)
+{
+  static uint8_t out[CORPUS_URI_BYTES];
+  size_t outLength = 0;
+  (void)unit;
+  datauriDecode(corpus_uri_lzss, out, sizeof(out), &outLength);
+  bench_sink ^= (uint32_t)outLength;
+  return CORPUS_URI_BYTES;
+}
+
+static size_t case_crc32(size_t unit)
+{
+  bench_sink ^= datauriCrc32_Update(0, &corpus_bytes[(unit % CORPUS_UNITS) * CORPUS_UNIT_BYTES], CORPUS_UNIT_BYTES);
+  return CORPUS_UNIT_BYTES;
+}
+
+static size_t bench_framing_roundtrip(size_t unit, bool useCobs)
+{
+  static uint8_t ringBuff[1021]; ///< Odd size so frames land on every wrap point
+  static circularBuffer_uint8_t ring = circularBuffer_uint8_struct_prefill(ringBuff);
+  static uint8_t frame[CORPUS_FRAME_BYTES];
+  static cobs_decoder_t cobs = cobs_decoder_struct_prefill(frame);
+  static slip_decoder_t slip = slip_decoder_struct_prefill(frame);
+  const uint8_t *packet = &corpus_bytes[(unit % (CORPUS_BYTES / CORPUS_FRAME_BYTES)) * CORPUS_FRAME_BYTES];
+  size_t frameLen = 0;
+  if (useCobs)
+  {
+    cobs_encode_to_ring(&ring, packet, CORPUS_FRAME_BYTES);
+    cobs_decode_from_ring(&cobs, &ring, &frameLen);
+  }
+  else
+  {
+    slip_encode_to_ring(&ring, packet, CORPUS_FRAME_BYTES);
+    slip_decode_from_ring(&slip, &ring, &frameLen);
+  }
+  bench_sink ^= (uint32_t)frameLen;
+  return CORPUS_FRAME_BYTES;
+}
+
+static size_t case_cobs_roundtrip(size_t unit)
+{
+  return bench_framing_roundtrip(unit, true);
+}
+
+static size_t case_slip_roundtrip(size_t unit)
+{
+  return bench_framing_roundtrip(unit, false);
+}
+
+typedef struct bench_case_t
+{
+  const char *name;          ///< Group/variant, used for --filter and the baseline file
+  size_t (*run)(size_t unit); ///< Process one unit, return input bytes covered
+} bench_case_t;
+
+static const bench_case_t bench_cases[] = {
+  {"hex/append_hex_loop",          case_hex_append_loop},
+  {"hex/append_hex_block",         case_hex_append_block},
+  {"hex/parse_hex_block",          case_hex_parse_block},
+  {"hex/hexdump",                  case_hexdump},
+  {"dec/snprintf_u",               case_dec_snprintf},
+  {"dec/append_uint32",            case_dec_append_uint32},
+  {"dec/strtoul",                  case_dec_strtoul},
+  {"dec/parse_uint32",             case_dec_parse_uint32},
+  {"fixed/snprintf_4f",            case_fixed_snprintf},
+  {"fixed/append_fixed",           case_fixed_append},
+  {"float/snprintf_9g",            case_float_snprintf},
+  {"float/append_float",           case_float_append},
+  {"help/gen_help_str",            case_help_gen},
+  {"help/gen_help_str_resumable",  case_help_resumable},
+  {"help/help_table_copy",         case_help_table_copy},
+  {"datauri/base64_encode",        case_datauri_base64_encode},
+  {"datauri/base64_crc32_encode",  case_datauri_base64_crc_encode},
+  {"datauri/z85_encode",           case_datauri_z85_encode},
+  {"datauri/lzss_encode",          case_datauri_lzss_encode},
+  {"datauri/base64_decode",        case_datauri_base64_decode},
+  {"datauri/lzss_crc32_decode",    case_datauri_lzss_decode},
+  {"datauri/crc32",                case_crc32},
+  {"framing/cobs_roundtrip",       case_cobs_roundtrip},
+  {"framing/slip_roundtrip",       case_slip_roundtrip},
+};
+#define BENCH_CASE_COUNT (sizeof(bench_cases) / sizeof(bench_cases[0]))
+
+
+/*******************************************************************************
+ * Measurement
+*******************************************************************************/
+
+typedef struct bench_result_t
+{
+  char name[BENCH_NAME_MAX];
+  double mb_per_s;        ///< Best of BENCH_RUNS
+  double ticks_per_byte;  ///< From the same run
+  uint64_t p50;           ///< Ticks per unit
+  uint64_t p99;           ///< Ticks per unit
+  uint64_t max;           ///< Ticks per unit
+  uint32_t hist[64];      ///< Units per power of two tick bucket
+} bench_result_t;
+
+static uint64_t bench_samples[BENCH_MAX_SAMPLES];
+
+static int bench_cmp_u64(const void *a, const void *b)
+{
+  const uint64_t x = *(const uint64_t *)a;
+  const uint64_t y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+static inline int bench_log2(uint64_t v)
+{
+  int bucket = 0;
+  while ((v >>= 1) != 0)
+    bucket++;
+  return bucket;
+}
+
+static void bench_run_case(const bench_case_t *c, bench_result_t *r)
+{
+  memset(r, 0, sizeof(*r));
+  snprintf(r->name, sizeof(r->name), "%s", c->name);
+
+  for (size_t unit = 0 ; unit < 64 ; unit++)
+    c->run(unit); // Warm up caches and first use tables
+
+  for (int run = 0 ; run < BENCH_RUNS ; run++)
+  {
+    size_t samples = 0;
+    size_t bytes = 0;
+    uint64_t ticks = 0;
+    const double start = bench_seconds();
+    double elapsed = 0;
+    while (((samples < BENCH_MIN_SAMPLES) || (elapsed < BENCH_MIN_SECONDS)) && (samples < BENCH_MAX_SAMPLES))
+    {
+      const uint64_t t0 = bench_ticks();
+      bytes += c->run(samples);
+      const uint64_t t1 = bench_ticks();
+      bench_samples[samples++] = t1 - t0;
+      ticks += t1 - t0;
+      if ((samples & 63) == 0)
+        elapsed = bench_seconds() - start;
+    }
+    elapsed = bench_seconds() - start;
+
+    const double mb_per_s = (double)bytes / elapsed / 1e6;
+    if (mb_per_s <= r->mb_per_s)
+      continue;
+    /* Keep the stats of the best run */
+    r->mb_per_s = mb_per_s;
+    r->ticks_per_byte = (double)ticks / (double)bytes;
+    memset(r->hist, 0, sizeof(r->hist));
+    for (size_t i = 0 ; i < samples ; i++)
+      r->hist[bench_log2(bench_samples[i])]++;
+    qsort(bench_samples, samples, sizeof(bench_samples[0]), bench_cmp_u64);
+    r->p50 = bench_samples[samples / 2];
+    r->p99 = bench_samples[(samples * 99) / 100];
+    r->max = bench_samples[samples - 1];
+  }
+}
+
+static void bench_print_hist(const bench_result_t *r)
+{
+  int lo = 63;
+  int hi = 0;
+  uint32_t peak = 1;
+  for (int b = 0 ; b < 64 ; b++)
+  {
+    if (r->hist[b] == 0)
+      continue;
+    lo = (b < lo) ? b : lo;
+    hi = (b > hi) ? b : hi;
+    peak = (r->hist[b] > peak) ? r->hist[b] : peak;
+  }
+  for (int b = lo ; b <= hi ; b++)
+  {
+    char bar[BENCH_HIST_WIDTH + 1];
+    const size_t len = (size_t)(((uint64_t)r->hist[b] * BENCH_HIST_WIDTH + peak - 1) / peak);
+    memset(bar, '#', len);
+    bar[len] = 0;
+    printf("    %10llu..%-10llu %8u %s\n", 1ull << b, (2ull << b) - 1, (unsigned)r->hist[b], bar);
+  }
+}
+
+
+/*******************************************************************************
+ * Baseline File
+*******************************************************************************/
+
+static bool bench_save(const char *path, const bench_result_t *results, size_t count)
+{
+  FILE *f = fopen(path, "w");
+  if (f == NULL)
+    return false; ///< Failed
+  fprintf(f, "# benchTextEncoding baseline, ticks are " BENCH_TICKS_NAME "\n");
+  fprintf(f, "# name MB/s ticks/byte p50 p99\n");
+  for (size_t i = 0 ; i < count ; i++)
+    fprintf(f, "%s %.1f %.4f %llu %llu\n", results[i].name, results[i].mb_per_s, results[i].ticks_per_byte, (unsigned long long)results[i].p50, (unsigned long long)results[i].p99);
+  fclose(f);
+  return true; ///< Successful
+}
+
+/*
+  Returns the number of failures, or -1 if the baseline could not be read. A failure is a case
+  more than `threshold_pct` slower, or a baseline case that no longer exists. Baseline cases
+  left out by --filter are listed but do not fail, as are new cases with no baseline yet.
+*/
+static int bench_compare(const char *path, const bench_result_t *results, size_t count, const char *filter, double threshold_pct)
+{
+  FILE *f = fopen(path, "r");
+  if (f == NULL)
+    return -1; ///< Failed
+  int failures = 0;
+  bool in_baseline[BENCH_CASE_COUNT] = {false};
+  char line[256];
+  printf("\n%-30s %10s %10s %8s\n", "compare", "base MB/s", "now MB/s", "change");
+  while (fgets(line, sizeof(line), f))
+  {
+    char name[BENCH_NAME_MAX];
+    double base_mb_per_s = 0;
+    if ((line[0] == '#') || (sscanf(line, "%63s %lf", name, &base_mb_per_s) != 2))
+      continue;
+    size_t i = 0;
+    while ((i < count) && (strcmp(results[i].name, name) != 0))
+      i++;
+    if (i == count)
+    { /* Not run: either filtered out, or the case is gone (renamed or removed) */
+      const bool filtered = filter && !strstr(name, filter);
+      failures += !filtered;
+      printf("%-30s %10.1f %10s %8s %s\n", name, base_mb_per_s, "-", "", filtered ? "not run (--filter)" : "MISSING");
+      continue;
+    }
+    in_baseline[i] = true;
+    const double change = (results[i].mb_per_s / base_mb_per_s - 1.0) * 100.0;
+    const bool regressed = change < -threshold_pct;
+    failures += regressed;
+    printf("%-30s %10.1f %10.1f %+7.1f%% %s\n", name, base_mb_per_s, results[i].mb_per_s, change, regressed ? "REGRESSION" : "");
+  }
+  fclose(f);
+  for (size_t i = 0 ; i < count ; i++)
+  {
+    if (!in_baseline[i])
+      printf("%-30s %10s %10.1f %8s %s\n", results[i].name, "-", results[i].mb_per_s, "", "new (no baseline)");
+  }
+  return failures;
+}
+
+
+int main(int argc, char *argv[])
+{
+  const char *filter = NULL;
+  const char *save_path = NULL;
+  const char *compare_path = NULL;
+  double threshold_pct = 10.0;
+  bool show_hist = false;
+
+  for (int i = 1 ; i < argc ; i++)
+  {
+    if ((strcmp(argv[i], "--filter") == 0) && (i + 1 < argc))
+      filter = argv[++i];
+    else if ((strcmp(argv[i], "--save") == 0) && (i + 1 < argc))
+      save_path = argv[++i];
+    else if ((strcmp(argv[i], "--compare") == 0) && (i + 1 < argc))
+      compare_path = argv[++i];
+    else if ((strcmp(argv[i], "--threshold") == 0) && (i + 1 < argc))
+      threshold_pct = atof(argv[++i]);
+    else if (strcmp(argv[i], "--hist") == 0)
+      show_hist = true;
+    else
+    {
+      fprintf(stderr, "usage: %s [--filter substr] [--hist] [--save file] [--compare file [--threshold pct]]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  corpus_init();
+
+  static bench_result_t results[BENCH_CASE_COUNT];
+  size_t count = 0;
+  printf("%-30s %10s %10s %10s %10s   (ticks: " BENCH_TICKS_NAME ")\n", "case", "MB/s", "tick/B", "p50/unit", "p99/unit");
+  for (size_t i = 0 ; i < BENCH_CASE_COUNT ; i++)
+  {
+    if (filter && !strstr(bench_cases[i].name, filter))
+      continue;
+    bench_result_t *r = &results[count++];
+    bench_run_case(&bench_cases[i], r);
+    printf("%-30s %10.1f %10.3f %10llu %10llu\n", r->name, r->mb_per_s, r->ticks_per_byte, (unsigned long long)r->p50, (unsigned long long)r->p99);
+    if (show_hist)
+      bench_print_hist(r);
+  }
+
+  if (save_path && !bench_save(save_path, results, count))
+  {
+    fprintf(stderr, "could not write %s\n", save_path);
+    return 2;
+  }
+
+  if (compare_path)
+  {
+    const int failures = bench_compare(compare_path, results, count, filter, threshold_pct);
+    if (failures < 0)
+    {
+      fprintf(stderr, "could not read %s\n", compare_path);
+      return 2;
+    }
+    if (failures > 0)
+    {
+      printf("%d case(s) regressed by more than %.1f%% or missing from this run\n", failures, threshold_pct);
+      return 1;
+    }
+    printf("no regressions beyond %.1f%%\n", threshold_pct);
+  }
+  return 0;
+}
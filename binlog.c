@@ -0,0 +1,497 @@
+//usr/bin/clang -DDEMO "$0" && exec ./a.out "$@"
+
+/*
+  Deferred formatting binary log over the circular byte buffer.
+
+  Formatting text at the call site (even with the minstrhex.c helpers) is too
+  slow for interrupt handlers and other hot paths. Instead a call site writes
+  a compact record into a ring:
+
+  ```
+  | id (2) | timestamp (4) | arg0 (4) | arg1 (4) | ... |   (host byte order)
+  ```
+
+  The format string and argument count live in a table that is expanded at
+  compile time from an X-macro (`BINLOG_FORMATS`), so the id is a constant and
+  the argument count is checked against the table when the call is compiled.
+  A background task (or a host tool fed the raw bytes) later turns records
+  back into text with `binlog_decode_record()` / `binlog_drain()`.
+
+  ```
+  #define BINLOG_FORMATS(X) \
+    X(BOOT,   2, "boot reason=%u fw=0x%x") \
+    X(SENSOR, 3, "sensor ch=%u temp=%q v=%f")
+  #include "binlog.c"
+
+  static uint8_t binlogBuff[1024];
+  static binlog_t binlog = binlog_struct_prefill(binlogBuff);
+
+  BINLOG(&binlog, SENSOR, ch, temp_q16, BINLOG_F32(volts));
+  BINLOG0(&binlog, ADC_OVERRUN); // No arguments (plain C11 needs at least one for BINLOG())
+  ```
+
+  When the ring is full, records are dropped and counted. A drop marker record
+  is queued by the next write that has room for it, so the decoder prints
+  "N records dropped" (with the timestamp of the first lost record) in order,
+  after the records that were queued before the loss.
+
+  Arguments are all stored as 32 bits. Format specs the decoder understands:
+    %u unsigned, %d signed, %x hex (8 digits), %q Q16.16 (4 digits),
+    %f float (pass with BINLOG_F32() so the bits are kept), %% literal '%'
+
+  The ring is shared between the call sites and the decoder, so define
+  `BINLOG_CRITICAL_ENTER(state)` / `BINLOG_CRITICAL_EXIT(state)` and
+  `BINLOG_TIMESTAMP()` (e.g. to a cycle counter) before including this file on
+  target. By default the timestamp is a record sequence number. `state` is a
+  local of type `BINLOG_IRQ_STATE_T`, so the interrupt mask saved on entry can
+  be restored on exit. Call sites may be in interrupt handlers, so use the ISR
+  safe forms (on FreeRTOS Cortex-M ports these are also fine in task context):
+
+  ```
+  #define BINLOG_IRQ_STATE_T           UBaseType_t
+  #define BINLOG_CRITICAL_ENTER(state) ((state) = taskENTER_CRITICAL_FROM_ISR())
+  #define BINLOG_CRITICAL_EXIT(state)  taskEXIT_CRITICAL_FROM_ISR(state)
+  ```
+
+  or on bare metal Cortex-M (CMSIS):
+
+  ```
+  #define BINLOG_IRQ_STATE_T           uint32_t
+  #define BINLOG_CRITICAL_ENTER(state) do { (state) = __get_PRIMASK(); __disable_irq(); } while (0)
+  #define BINLOG_CRITICAL_EXIT(state)  __set_PRIMASK(state)
+  ```
+
+  Benchmark: clang -O2 -DBENCH binlog.c && ./a.out
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Reuse the ring and the append helpers without their demo/test mains */
+#pragma push_macro("DEMO")
+#pragma push_macro("TEST")
+#pragma push_macro("BENCH")
+#undef DEMO
+#undef TEST
+#undef BENCH
+#include "circularByteBuff_ptrBased.c"
+#include "minstrhex.c"
+#pragma pop_macro("BENCH")
+#pragma pop_macro("TEST")
+#pragma pop_macro("DEMO")
+
+#ifndef BINLOG_FORMATS
+#define BINLOG_FORMATS(X)                                   \
+  X(BOOT,        2, "boot reason=%u fw=0x%x")               \
+  X(SENSOR,      3, "sensor ch=%u temp=%q v=%f")            \
+  X(ADC_OVERRUN, 0, "adc overrun")                          \
+  X(CLI_CMD,     2, "cli cmd=0x%x result=%d")
+#endif
+
+#ifndef BINLOG_CRITICAL_ENTER
+#define BINLOG_IRQ_STATE_T           uint32_t
+#define BINLOG_CRITICAL_ENTER(state) ((state) = 0)
+#define BINLOG_CRITICAL_EXIT(state)  ((void)(state))
+#endif
+
+#ifndef BINLOG_TIMESTAMP
+#define BINLOG_TIMESTAMP(log) ((log)->sequence++)
+#endif
+
+#define BINLOG_MAX_ARGS     8
+#define BINLOG_HEADER_SIZE  6 ///< id (2) + timestamp (4)
+#define BINLOG_RECORD_MAX   (BINLOG_HEADER_SIZE + (BINLOG_MAX_ARGS * 4))
+#define BINLOG_LINE_MAX     128
+#define BINLOG_DROPPED_SIZE (BINLOG_HEADER_SIZE + 4) ///< Drop marker record: count of records lost
+
+/* Compile time ids and argument counts from the format table */
+#define BINLOG_X_ID(name, argc, fmt)   BINLOG_ID_##name,
+#define BINLOG_X_ARGC(name, argc, fmt) BINLOG_ARGC_##name = (argc),
+typedef enum binlog_id_t { BINLOG_FORMATS(BINLOG_X_ID) BINLOG_ID_DROPPED, BINLOG_ID_COUNT } binlog_id_t;
+enum { BINLOG_FORMATS(BINLOG_X_ARGC) };
+#undef BINLOG_X_ID
+#undef BINLOG_X_ARGC
+
+// Prefill Binary Log (Allows for skipping `binlog_init()`)
+#define binlog_struct_prefill(Buff)                        \
+{                                                          \
+  .ring             = circularBuffer_uint8_struct_prefill(Buff), \
+  .sequence         = 0,                                   \
+  .dropped          = 0,                                   \
+  .dropped_pending  = 0,                                   \
+  .dropped_timestamp = 0                                   \
+}
+
+typedef struct binlog_t
+{
+  circularBuffer_uint8_t ring; ///< Pending records
+  uint32_t sequence;           ///< Default timestamp (records written, including dropped)
+  uint32_t dropped;            ///< Records dropped because the ring was full (or lost with sync)
+  uint32_t dropped_pending;    ///< Records dropped since the last drop marker was queued
+  uint32_t dropped_timestamp;  ///< Timestamp of the first of the pending dropped records
+} binlog_t;
+
+
+/*******************************************************************************
+ * Writing Records (Call Site)
+*******************************************************************************/
+
+static inline bool binlog_init(binlog_t *log, uint8_t *buffer, size_t size)
+{
+  if (log == NULL)
+    return false; ///< Failed
+  log->sequence = 0;
+  log->dropped = 0;
+  log->dropped_pending = 0;
+  log->dropped_timestamp = 0;
+  return circularBuffer_uint8_Init(&log->ring, size, buffer);
+}
+
+/* Keep the bits of a float, rather than converting its value to an integer */
+static inline uint32_t binlog_f32(float val)
+{
+  uint32_t bits;
+  memcpy(&bits, &val, sizeof(bits));
+  return bits;
+}
+#define BINLOG_F32(val) binlog_f32(val)
+
+/* Queue one whole record (call with the critical section held) */
+static inline bool binlog_enqueue(circularBuffer_uint8_t *cb, uint16_t id, uint32_t timestamp, const uint32_t *args, size_t argc)
+{
+  const size_t size = BINLOG_HEADER_SIZE + (argc * sizeof(uint32_t));
+  if (((cb->capacity - cb->count) >= size) && ((size_t)(cb->bufferEnd - cb->tail) > size))
+  { /* Usual case: fits before the end of the buffer, write straight into the ring */
+    memcpy(&cb->tail[0], &id, sizeof(id));
+    memcpy(&cb->tail[2], &timestamp, sizeof(timestamp));
+    memcpy(&cb->tail[BINLOG_HEADER_SIZE], args, argc * sizeof(uint32_t));
+    cb->tail += size;
+    cb->count += size;
+    return true; ///< Successful
+  }
+  /* Wraps (or full): assemble then enqueue in one piece */
+  uint8_t record[BINLOG_RECORD_MAX];
+  memcpy(&record[0], &id, sizeof(id));
+  memcpy(&record[2], &timestamp, sizeof(timestamp));
+  memcpy(&record[BINLOG_HEADER_SIZE], args, argc * sizeof(uint32_t));
+  return circularBuffer_uint8_EnqueueBlock(cb, record, size);
+}
+
+static inline bool binlog_write(binlog_t *log, uint16_t id, const uint32_t *args, size_t argc)
+{
+  circularBuffer_uint8_t *cb = &log->ring;
+  const size_t size = BINLOG_HEADER_SIZE + (argc * sizeof(uint32_t));
+  bool ok = false;
+  BINLOG_IRQ_STATE_T binlog_irq_state;
+  BINLOG_CRITICAL_ENTER(binlog_irq_state);
+  const uint32_t timestamp = BINLOG_TIMESTAMP(log);
+  if ((log->dropped_pending > 0) && ((cb->capacity - cb->count) >= (BINLOG_DROPPED_SIZE + size)))
+  { /* Mark where records were lost, so the decoder reports it in order (only with room for this record too) */
+    binlog_enqueue(cb, BINLOG_ID_DROPPED, log->dropped_timestamp, &log->dropped_pending, 1);
+    log->dropped_pending = 0;
+  }
+  if (log->dropped_pending == 0)
+    ok = binlog_enqueue(cb, id, timestamp, args, argc);
+  if (!ok)
+  {
+    if (log->dropped_pending == 0)
+      log->dropped_timestamp = timestamp;
+    log->dropped_pending++;
+    log->dropped++;
+  }
+  BINLOG_CRITICAL_EXIT(binlog_irq_state);
+  return ok;
+}
+
+/* A leading 0 keeps the array valid when there are no arguments */
+#define BINLOG_ARGS(...) (((const uint32_t[]){0, __VA_ARGS__}) + 1)
+#define BINLOG_ARGC(...) ((sizeof((const uint32_t[]){0, __VA_ARGS__}) / sizeof(uint32_t)) - 1)
+
+/* BINLOG(log, NAME, args...): argument count is checked against the table at compile time */
+#define BINLOG(log, name, ...)                                                              \
+  do {                                                                                      \
+    (void)sizeof(char[(BINLOG_ARGC(__VA_ARGS__) == BINLOG_ARGC_##name) ? 1 : -1]);          \
+    (void)sizeof(char[(BINLOG_ARGC_##name <= BINLOG_MAX_ARGS) ? 1 : -1]);                   \
+    binlog_write((log), BINLOG_ID_##name, BINLOG_ARGS(__VA_ARGS__), BINLOG_ARGC_##name);    \
+  } while (0)
+
+/* BINLOG0(log, NAME): ids with no arguments (before C23 a variadic macro needs at least one) */
+#define BINLOG0(log, name)                                                                  \
+  do {                                                                                      \
+    (void)sizeof(char[(BINLOG_ARGC_##name == 0) ? 1 : -1]);                                 \
+    binlog_write((log), BINLOG_ID_##name, BINLOG_ARGS(0), 0);                               \
+  } while (0)
+
+
+/*******************************************************************************
+ * Decoding Records (Background Task Or Host Tool)
+*******************************************************************************/
+#ifndef BINLOG_NO_DECODER // Firmware that ships raw records to a host can leave the format strings out
+
+typedef struct binlog_format_t
+{
+  const char *name;   ///< Id name from the table
+  uint8_t argc;       ///< Number of 32 bit arguments
+  const char *format; ///< Format string
+} binlog_format_t;
+
+#define BINLOG_X_FORMAT(name, argc, fmt) { #name, (argc), (fmt) },
+static const binlog_format_t binlog_formats[BINLOG_ID_COUNT] = { BINLOG_FORMATS(BINLOG_X_FORMAT) BINLOG_X_FORMAT(DROPPED, 1, "%u records dropped") };
+#undef BINLOG_X_FORMAT
+
+/* Size of the record at `data`, or 0 if the id is unknown */
+static inline size_t binlog_record_size(const uint8_t *data)
+{
+  uint16_t id;
+  memcpy(&id, data, sizeof(id));
+  if (id >= BINLOG_ID_COUNT)
+    return 0;
+  return BINLOG_HEADER_SIZE + (binlog_formats[id].argc * sizeof(uint32_t));
+}
+
+/* Format one record as "[timestamp] text\n". Returns false if the record is invalid */
+bool binlog_decode_record(const uint8_t *data, size_t len, minstr_t *sb)
+{
+  uint16_t id;
+  uint32_t timestamp;
+  if ((len < BINLOG_HEADER_SIZE) || (binlog_record_size(data) != len))
+    return false; ///< Failed: Unknown id or truncated record
+  memcpy(&id, &data[0], sizeof(id));
+  memcpy(&timestamp, &data[2], sizeof(timestamp));
+
+  minstr_append_char(sb, '[');
+  minstr_append_u32_pad(sb, timestamp, 10);
+  minstr_append_str(sb, "] ");
+
+  const char *fmt = binlog_formats[id].format;
+  const uint8_t *arg = &data[BINLOG_HEADER_SIZE];
+  while (*fmt)
+  {
+    /* Copy the literal run up to the next spec in one go */
+    const size_t span = strcspn(fmt, "%");
+    minstr_append_mem(sb, fmt, span);
+    fmt += span;
+    if (*fmt == '\0')
+      break;
+
+    const char spec = fmt[1];
+    if (spec == '\0')
+      break; ///< Stray '%' at the end
+    fmt += 2;
+    if (spec == '%')
+    {
+      minstr_append_char(sb, '%');
+      continue;
+    }
+    if (arg >= &data[len])
+    {
+      minstr_append_str(sb, "<missing>");
+      continue;
+    }
+
+    uint32_t val;
+    memcpy(&val, arg, sizeof(val));
+    arg += sizeof(val);
+    switch (spec)
+    {
+      case 'u': minstr_append_u32(sb, val); break;
+      case 'd': minstr_append_i32(sb, (int32_t)val); break;
+      case 'x': minstr_append_hex32(sb, val); break;
+      case 'q': minstr_append_fixed(sb, (int32_t)val, 16, 4); break;
+      case 'f':
+      {
+        float f;
+        memcpy(&f, &val, sizeof(f));
+        minstr_append_float(sb, f);
+        break;
+      }
+      default: minstr_append_str(sb, "<bad spec>"); break;
+    }
+  }
+
+  minstr_append_char(sb, '\n');
+  return true; ///< Successful
+}
+
+/* Take the oldest record off the ring and format it. Returns false once the ring is empty */
+bool binlog_decode_next(binlog_t *log, minstr_t *sb)
+{
+  uint8_t record[BINLOG_RECORD_MAX];
+  size_t size = 0;
+  bool ok = false;
+  size_t lost_bytes = 0;
+  uint32_t lost_records = 0;
+  BINLOG_IRQ_STATE_T binlog_irq_state;
+
+  BINLOG_CRITICAL_ENTER(binlog_irq_state);
+  if (circularBuffer_uint8_DequeueBlock(&log->ring, record, BINLOG_HEADER_SIZE))
+  {
+    size = binlog_record_size(record);
+    if (size == 0)
+    { /* Lost sync (should not happen). Start again, counting the discarded records (at least one per max record size) */
+      lost_bytes = BINLOG_HEADER_SIZE + circularBuffer_uint8_Count(&log->ring);
+      lost_records = (uint32_t)((lost_bytes + BINLOG_RECORD_MAX - 1) / BINLOG_RECORD_MAX);
+      log->dropped += lost_records;
+      circularBuffer_uint8_Reset(&log->ring);
+    }
+    else
+      ok = circularBuffer_uint8_DequeueBlock(&log->ring, &record[BINLOG_HEADER_SIZE], size - BINLOG_HEADER_SIZE);
+  }
+  else if (log->dropped_pending > 0)
+  { /* Ring drained with no later write to mark the loss, so every older record is out: report it now */
+    const uint16_t id = BINLOG_ID_DROPPED;
+    memcpy(&record[0], &id, sizeof(id));
+    memcpy(&record[2], &log->dropped_timestamp, sizeof(log->dropped_timestamp));
+    memcpy(&record[BINLOG_HEADER_SIZE], &log->dropped_pending, sizeof(log->dropped_pending));
+    size = BINLOG_DROPPED_SIZE;
+    log->dropped_pending = 0;
+    ok = true;
+  }
+  BINLOG_CRITICAL_EXIT(binlog_irq_state);
+
+  if (lost_bytes)
+  {
+    minstr_append_str(sb, "[----------] lost sync, ");
+    minstr_append_u32(sb, (uint32_t)lost_bytes);
+    minstr_append_str(sb, " bytes (at least ");
+    minstr_append_u32(sb, lost_records);
+    minstr_append_str(sb, " records) dropped\n");
+    return true;
+  }
+  if (ok)
+    return binlog_decode_record(record, size, sb);
+  return false; ///< Nothing to report
+}
+
+/* Decode every pending record, one line at a time, into `write_fcptr` */
+size_t binlog_drain(binlog_t *log, void (*write_fcptr)(const char *block, size_t len))
+{
+  char line[BINLOG_LINE_MAX];
+  size_t records = 0;
+  for (;;)
+  {
+    minstr_t sb = minstr_struct_prefill(line);
+    if (!binlog_decode_next(log, &sb))
+      break;
+    write_fcptr(line, minstr_length(&sb));
+    records++;
+  }
+  return records;
+}
+
+#endif // BINLOG_NO_DECODER
+
+
+#ifdef DEMO
+static void demo_stdout_write(const char *block, size_t len)
+{
+  fwrite(block, 1, len, stdout);
+}
+
+int main(void)
+{
+  static uint8_t binlogBuff[64];
+  binlog_t binlog = binlog_struct_prefill(binlogBuff);
+
+  BINLOG(&binlog, BOOT, 3, 0x00010203);
+  BINLOG(&binlog, SENSOR, 2, (uint32_t)(int32_t)(-21.25 * 65536), BINLOG_F32(3.3f));
+  BINLOG0(&binlog, ADC_OVERRUN);
+  binlog_drain(&binlog, demo_stdout_write);
+
+  /* Ring only fits a few records, the rest are counted as dropped */
+  for (int i = 0 ; i < 6 ; i++)
+    BINLOG(&binlog, CLI_CMD, 0xC0DE0000u + i, -i);
+
+  /* Decoding two frees room, so the next write queues the drop marker (in order) before itself */
+  char line[BINLOG_LINE_MAX];
+  for (int i = 0 ; i < 2 ; i++)
+  {
+    minstr_t sb = minstr_struct_prefill(line);
+    binlog_decode_next(&binlog, &sb);
+    demo_stdout_write(line, minstr_length(&sb));
+  }
+  BINLOG(&binlog, BOOT, 4, 0x00010203);
+  binlog_drain(&binlog, demo_stdout_write);
+
+  /* Drops with no later write are reported once the ring has drained */
+  for (int i = 0 ; i < 6 ; i++)
+    BINLOG(&binlog, CLI_CMD, 0xC0DE0010u + i, i);
+  binlog_drain(&binlog, demo_stdout_write);
+  return 0;
+}
+#endif //DEMO
+
+#ifdef BENCH
+/*******************************************************************************
+ * Benchmark: BINLOG vs MINSTR_FMT vs snprintf per log call
+*******************************************************************************/
+#include <time.h>
+
+static double bench_seconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static size_t bench_chars = 0;
+static void bench_sink(const char *block, size_t len)
+{
+  (void)block;
+  bench_chars += len;
+}
+
+#define BENCH_BATCH 1000 ///< Records per drain (fits in the ring)
+
+int main(void)
+{
+  static uint8_t binlogBuff[BENCH_BATCH * (BINLOG_HEADER_SIZE + 3 * 4)];
+  binlog_t binlog = binlog_struct_prefill(binlogBuff);
+  const int batches = 5000;
+  double write_time = 0;
+  double drain_time = 0;
+  char line[BINLOG_LINE_MAX];
+  size_t chars = 0;
+
+  for (int b = 0 ; b < batches ; b++)
+  {
+    double t0 = bench_seconds();
+    for (int i = 0 ; i < BENCH_BATCH ; i++)
+      BINLOG(&binlog, SENSOR, (uint32_t)i, (uint32_t)(i * 1000), BINLOG_F32((float)i * 0.25f));
+    double t1 = bench_seconds();
+    binlog_drain(&binlog, bench_sink);
+    double t2 = bench_seconds();
+    write_time += t1 - t0;
+    drain_time += t2 - t1;
+  }
+  if (binlog.dropped)
+    printf("dropped %u\n", (unsigned)binlog.dropped);
+
+  double t3 = bench_seconds();
+  for (int b = 0 ; b < batches ; b++)
+  {
+    for (int i = 0 ; i < BENCH_BATCH ; i++)
+    {
+      minstr_t sb = minstr_struct_prefill(line);
+      MINSTR_FMT(&sb, MINSTR_S("sensor ch="), MINSTR_U32((uint32_t)i), MINSTR_S(" temp="), MINSTR_FIX(i * 1000, 16, 4), MINSTR_S(" v="), MINSTR_F32((float)i * 0.25f));
+      chars += minstr_length(&sb);
+    }
+  }
+  double t4 = bench_seconds();
+  for (int b = 0 ; b < batches ; b++)
+  {
+    for (int i = 0 ; i < BENCH_BATCH ; i++)
+      chars += (size_t)snprintf(line, sizeof(line), "sensor ch=%u temp=%.4f v=%g", (unsigned)i, (double)(i * 1000) / 65536.0, (double)((float)i * 0.25f));
+  }
+  double t5 = bench_seconds();
+
+  const double calls = (double)BENCH_BATCH * batches;
+  printf("BINLOG call site        : %6.2f ns/call\n", write_time * 1e9 / calls);
+  printf("binlog_drain (deferred) : %6.2f ns/record (%zu chars)\n", drain_time * 1e9 / calls, bench_chars);
+  printf("MINSTR_FMT in place     : %6.2f ns/call\n", (t4 - t3) * 1e9 / calls);
+  printf("snprintf in place       : %6.2f ns/call (%zu chars)\n", (t5 - t4) * 1e9 / calls, chars);
+  return 0;
+}
+#endif //BENCH
@@ -14,6 +14,7 @@
 #include <stdint.h> // uint8_t
 #include <stddef.h> // size_t
 #include <stdbool.h> // bool
+#include <string.h> // memcpy
 
 // Prefill Circular Buffer (Allows for skipping `circularBuffer_uint8_Init()`)
 #define circularBuffer_uint8_struct_full_prefill(BuffSize, BuffPtr) \
@@ -119,6 +120,43 @@ static inline bool circularBuffer_uint8_Dequeue(circularBuffer_uint8_t *cb, uint
 }
 
 
+/*******************************************************************************
+ * Circular byte buffer Block Enqueue/Dequeue (All or nothing, This will modify the buffer)
+*******************************************************************************/
+
+static inline bool circularBuffer_uint8_EnqueueBlock(circularBuffer_uint8_t *cb, const uint8_t *data, const size_t len)
+{
+  // Enough Space?
+  if ((cb->capacity - cb->count) < len)
+    return false; ///< Failed
+  // Push up to the end of the buffer, then the rest from the start
+  const size_t firstLen = ((cb->capacity - cb->tail) < len) ? (cb->capacity - cb->tail) : len;
+  memcpy(&cb->buffer[cb->tail], data, firstLen);
+  memcpy(&cb->buffer[0], data + firstLen, len - firstLen);
+  // Increment tail
+  cb->tail = (firstLen < len) ? (len - firstLen) : (cb->tail + len);
+  cb->tail = (cb->tail == cb->capacity) ? 0 : cb->tail;
+  cb->count = cb->count + len;
+  return true; ///< Successful
+}
+
+static inline bool circularBuffer_uint8_DequeueBlock(circularBuffer_uint8_t *cb, uint8_t *data, const size_t len)
+{
+  // Enough Data?
+  if (cb->count < len)
+    return false; ///< Failed
+  // Pop up to the end of the buffer, then the rest from the start
+  const size_t firstLen = ((cb->capacity - cb->head) < len) ? (cb->capacity - cb->head) : len;
+  memcpy(data, &cb->buffer[cb->head], firstLen);
+  memcpy(data + firstLen, &cb->buffer[0], len - firstLen);
+  // Increment head
+  cb->head = (firstLen < len) ? (len - firstLen) : (cb->head + len);
+  cb->head = (cb->head == cb->capacity) ? 0 : cb->head;
+  cb->count = cb->count - len;
+  return true; ///< Successful
+}
+
+
 /*******************************************************************************
  * Circular byte buffer Peek (Will Not Modify Buffer)
 *******************************************************************************/
@@ -135,6 +173,62 @@ static inline bool circularBuffer_uint8_Peek(circularBuffer_uint8_t *cb, uint8_t
 }
 
 
+/*******************************************************************************
+ * Circular byte buffer Spans (Direct access to the buffer memory for zero copy)
+*******************************************************************************/
+
+// Contiguous bytes ready to read at the head (up to the wrap point). Call Discard() once used
+static inline bool circularBuffer_uint8_ReadSpan(circularBuffer_uint8_t *cb, const uint8_t **span, size_t *spanLen)
+{
+  // Empty?
+  if (cb->count == 0)
+    return false; ///< Failed
+  const size_t toEnd = cb->capacity - cb->head;
+  *span = &cb->buffer[cb->head];
+  *spanLen = (cb->count < toEnd) ? cb->count : toEnd;
+  return true; ///< Successful
+}
+
+static inline bool circularBuffer_uint8_Discard(circularBuffer_uint8_t *cb, const size_t len)
+{
+  // Enough Data?
+  if (cb->count < len)
+    return false; ///< Failed
+  // Increment head
+  cb->head = cb->head + len;
+  cb->head = (cb->head >= cb->capacity) ? (cb->head - cb->capacity) : cb->head;
+  cb->count = cb->count - len;
+  return true; ///< Successful
+}
+
+// Contiguous free space starting `offset` bytes past the tail. Fill it, then Commit() to make it readable
+static inline bool circularBuffer_uint8_WriteSpan(circularBuffer_uint8_t *cb, const size_t offset, uint8_t **span, size_t *spanLen)
+{
+  const size_t space = cb->capacity - cb->count;
+  // Enough Space?
+  if (offset >= space)
+    return false; ///< Failed
+  size_t index = cb->tail + offset;
+  index = (index >= cb->capacity) ? (index - cb->capacity) : index;
+  const size_t toEnd = cb->capacity - index;
+  *span = &cb->buffer[index];
+  *spanLen = ((space - offset) < toEnd) ? (space - offset) : toEnd;
+  return true; ///< Successful
+}
+
+static inline bool circularBuffer_uint8_Commit(circularBuffer_uint8_t *cb, const size_t len)
+{
+  // Enough Space?
+  if ((cb->capacity - cb->count) < len)
+    return false; ///< Failed
+  // Increment tail
+  cb->tail = cb->tail + len;
+  cb->tail = (cb->tail >= cb->capacity) ? (cb->tail - cb->capacity) : cb->tail;
+  cb->count = cb->count + len;
+  return true; ///< Successful
+}
+
+
 /*******************************************************************************
  * Circular byte buffer utility functions (Will Not Modify Buffer)
 *******************************************************************************/
@@ -271,12 +365,69 @@ char * cbuff_test_peek(void)
   return 0;
 }
 
+char * cbuff_test_block(void)
+{
+  uint8_t cbuffer[5] = {0};
+  circularBuffer_uint8_t prefilledBuff = circularBuffer_uint8_struct_prefill(cbuffer);
+  const uint8_t in[4] = {1, 2, 3, 4};
+  uint8_t out[4] = {0};
+  // Walk the start position all the way round so every wrap point is covered
+  for (int i = 0 ; i < 5 ; i++)
+  {
+    mu_assert("", circularBuffer_uint8_EnqueueBlock(&prefilledBuff, in, 4));
+    mu_assert("", !circularBuffer_uint8_EnqueueBlock(&prefilledBuff, in, 2)); // All or nothing
+    mu_assert("", circularBuffer_uint8_Count(&prefilledBuff) == 4);
+    mu_assert("", circularBuffer_uint8_DequeueBlock(&prefilledBuff, out, 3));
+    mu_assert("", (out[0] == 1) && (out[1] == 2) && (out[2] == 3));
+    mu_assert("", !circularBuffer_uint8_DequeueBlock(&prefilledBuff, out, 2)); // All or nothing
+    mu_assert("", circularBuffer_uint8_Dequeue(&prefilledBuff, &out[3]) && (out[3] == 4));
+    mu_assert("", circularBuffer_uint8_IsEmpty(&prefilledBuff));
+  }
+  return 0;
+}
+
+char * cbuff_test_span(void)
+{
+  uint8_t cbuffer[5] = {0};
+  circularBuffer_uint8_t prefilledBuff = circularBuffer_uint8_struct_prefill(cbuffer);
+  const uint8_t *readSpan = NULL;
+  uint8_t *writeSpan = NULL;
+  size_t spanLen = 0;
+  mu_assert("", !circularBuffer_uint8_ReadSpan(&prefilledBuff, &readSpan, &spanLen));
+  // Move the head and tail to index 3, so spans split at the wrap point
+  for (int i = 0 ; i < 3 ; i++)
+    circularBuffer_uint8_Enqueue(&prefilledBuff, 0);
+  mu_assert("", circularBuffer_uint8_Discard(&prefilledBuff, 3));
+  mu_assert("", circularBuffer_uint8_WriteSpan(&prefilledBuff, 0, &writeSpan, &spanLen));
+  mu_assert("", (writeSpan == &cbuffer[3]) && (spanLen == 2));
+  writeSpan[0] = 10;
+  writeSpan[1] = 11;
+  mu_assert("", circularBuffer_uint8_WriteSpan(&prefilledBuff, 2, &writeSpan, &spanLen));
+  mu_assert("", (writeSpan == &cbuffer[0]) && (spanLen == 3));
+  writeSpan[0] = 12;
+  mu_assert("", !circularBuffer_uint8_WriteSpan(&prefilledBuff, 5, &writeSpan, &spanLen));
+  mu_assert("", circularBuffer_uint8_IsEmpty(&prefilledBuff)); // Nothing readable until committed
+  mu_assert("", circularBuffer_uint8_Commit(&prefilledBuff, 3));
+  mu_assert("", circularBuffer_uint8_Count(&prefilledBuff) == 3);
+  mu_assert("", circularBuffer_uint8_ReadSpan(&prefilledBuff, &readSpan, &spanLen));
+  mu_assert("", (readSpan == &cbuffer[3]) && (spanLen == 2) && (readSpan[0] == 10) && (readSpan[1] == 11));
+  mu_assert("", circularBuffer_uint8_Discard(&prefilledBuff, spanLen));
+  mu_assert("", circularBuffer_uint8_ReadSpan(&prefilledBuff, &readSpan, &spanLen));
+  mu_assert("", (readSpan == &cbuffer[0]) && (spanLen == 1) && (readSpan[0] == 12));
+  mu_assert("", !circularBuffer_uint8_Discard(&prefilledBuff, 2));
+  mu_assert("", circularBuffer_uint8_Discard(&prefilledBuff, 1));
+  mu_assert("", circularBuffer_uint8_IsEmpty(&prefilledBuff));
+  return 0;
+}
+
 static char * all_tests()
 {
   mu_run_test(cbuff_test_prefill);
   mu_run_test(cbuff_test_general);
   mu_run_test(cbuff_test_overwrite);
   mu_run_test(cbuff_test_peek);
+  mu_run_test(cbuff_test_block);
+  mu_run_test(cbuff_test_span);
   return 0;
 }
 
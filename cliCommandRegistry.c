@@ -0,0 +1,436 @@
+//usr/bin/clang -DDEMO "$0" && exec ./a.out "$@"
+
+/*
+  CLI command registry with perfect hash lookup by command name.
+
+  FreeRTOS-Plus-CLI keeps commands in a linked list (`xRegisteredCommands`) and
+  both dispatch and help walk that list doing string compares on every line
+  entered. With a few hundred commands and scripted input this gets slow.
+
+  This registry keeps commands in an array (registration order, used for help)
+  and builds a hash-and-displace perfect hash over the command names into
+  static, caller supplied tables (no malloc). Lookup is then one hash of the
+  first token of the line, one slot read and a single string compare.
+
+  Building the hash is a one time cost of up to buckets x 256 seeds x command
+  count name hashes, so call `cli_registry_build()` at init once every command
+  is registered rather than leaving it to the first command typed:
+
+  ```
+  for (size_t i = 0; i < command_count; i++)
+    cli_registry_register(&reg, &commands[i]);
+  cli_registry_build(&reg); // Pay the build cost here, not on the first dispatch
+  ```
+
+  As a fallback the hash is rebuilt lazily on the first lookup after a later
+  registration. If no seed places every command, lookups fall back to a linear
+  scan until the next registration rather than retrying the build on every
+  line. The registry `generation` counter feeds `help_table_is_stale()` from
+  genhelpstr.c so the pre-rendered help is kept in sync as well.
+*/
+
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Reuse gen_help_str() and help_table_*() without its demo/test mains */
+#pragma push_macro("DEMO")
+#pragma push_macro("TEST")
+#pragma push_macro("BENCH")
+#undef DEMO
+#undef TEST
+#undef BENCH
+#include "genhelpstr.c"
+#pragma pop_macro("BENCH")
+#pragma pop_macro("TEST")
+#pragma pop_macro("DEMO")
+
+typedef bool (*cli_handler_t)(char *write_buffer, size_t write_buffer_len, const char *command_string);
+
+typedef struct cli_command_t
+{
+  const char *command;     ///< Command name (as typed)
+  const char *help_string; ///< Help string ('...' is replaced with the command name)
+  cli_handler_t handler;   ///< Command interpreter
+} cli_command_t;
+
+typedef struct cli_registry_t
+{
+  const cli_command_t **commands; ///< Registered commands (registration order)
+  size_t count;                   ///< Number of registered commands
+  size_t capacity;                ///< Maximum number of commands
+  uint16_t *slots;                ///< Perfect hash slots (command index + 1, 0 if empty)
+  size_t slot_count;              ///< Number of slots (power of 2, at least capacity)
+  uint8_t *seeds;                 ///< Displacement seed per bucket
+  size_t bucket_count;            ///< Number of buckets
+  uint32_t generation;            ///< Incremented on every registration
+  bool hash_valid;                ///< Perfect hash matches current command set
+  bool hash_failed;               ///< Build failed for current command set (lookups use a linear scan)
+} cli_registry_t;
+
+// Prefill Registry (Allows for skipping `cli_registry_init()`)
+// SlotBuff must be a power of 2 in size. Twice the command capacity makes the hash quick to build.
+// Slots hold 16 bit command indexes, so at most UINT16_MAX commands can be registered.
+#define cli_registry_struct_prefill(CommandBuff, SlotBuff, SeedBuff)          \
+{                                                                             \
+  .commands     = CommandBuff,                                                \
+  .count        = 0,                                                          \
+  .capacity     = (sizeof(CommandBuff)/sizeof(CommandBuff[0])),               \
+  .slots        = SlotBuff,                                                   \
+  .slot_count   = (sizeof(SlotBuff)/sizeof(SlotBuff[0])),                     \
+  .seeds        = SeedBuff,                                                   \
+  .bucket_count = (sizeof(SeedBuff)/sizeof(SeedBuff[0])),                     \
+  .generation   = 0,                                                          \
+  .hash_valid   = false,                                                      \
+  .hash_failed  = false                                                       \
+}
+
+
+/*******************************************************************************
+ * Hashing
+*******************************************************************************/
+
+/* Seeded FNV-1a over a command name. The name ends at '\0' or whitespace, so a raw command line can be hashed in place */
+static inline uint32_t cli_registry_hash(const char *name, size_t *name_len, uint32_t seed)
+{
+  uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+  size_t i = 0;
+  for (; (name[i] != '\0') && (name[i] != ' ') && (name[i] != '\t') && (name[i] != '\r') && (name[i] != '\n'); i++)
+  {
+    h ^= (uint8_t)name[i];
+    h *= 16777619u;
+  }
+  *name_len = i;
+  /* Final avalanche so the low bits used for masking are well mixed */
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  return h;
+}
+
+static inline size_t cli_registry_bucket(const cli_registry_t *reg, const char *name, size_t *name_len)
+{
+  return cli_registry_hash(name, name_len, 0) % reg->bucket_count;
+}
+
+static inline size_t cli_registry_slot(const cli_registry_t *reg, const char *name, uint8_t seed)
+{
+  size_t name_len;
+  return cli_registry_hash(name, &name_len, (uint32_t)seed + 1) & (reg->slot_count - 1);
+}
+
+
+/*******************************************************************************
+ * Init/Register/Build
+*******************************************************************************/
+
+static inline bool cli_registry_init(
+    cli_registry_t *reg,
+    const cli_command_t **commands, size_t capacity,
+    uint16_t *slots, size_t slot_count,
+    uint8_t *seeds, size_t bucket_count
+  )
+{
+  if ((reg == NULL) || (commands == NULL) || (slots == NULL) || (seeds == NULL))
+    return false; ///< Failed
+  if ((slot_count < capacity) || (slot_count & (slot_count - 1)) || (bucket_count == 0))
+    return false; ///< Failed: slot_count must be a power of 2 and fit all commands
+  if (capacity > UINT16_MAX)
+    return false; ///< Failed: Slots only hold 16 bit command indexes
+  cli_registry_t empty = {0};
+  *reg = empty;
+  reg->commands = commands;
+  reg->capacity = capacity;
+  reg->slots = slots;
+  reg->slot_count = slot_count;
+  reg->seeds = seeds;
+  reg->bucket_count = bucket_count;
+  return true; ///< Successful
+}
+
+static inline bool cli_registry_register(cli_registry_t *reg, const cli_command_t *command)
+{
+  if ((command == NULL) || (command->command == NULL))
+    return false; ///< Failed
+  if ((reg->count >= reg->capacity) || (reg->count >= UINT16_MAX))
+    return false; ///< Failed: Registry full
+  for (size_t i = 0; i < reg->count; i++)
+  {
+    if (strcmp(reg->commands[i]->command, command->command) == 0)
+      return false; ///< Failed: Name already registered (no perfect hash can separate duplicates)
+  }
+  reg->commands[reg->count++] = command;
+  reg->generation++;
+  reg->hash_valid = false;
+  reg->hash_failed = false;
+  return true; ///< Successful
+}
+
+/* Try to place every command of one bucket using the given seed */
+static inline bool cli_registry_place_bucket(cli_registry_t *reg, size_t bucket, uint8_t seed)
+{
+  size_t placed = 0;
+  for (size_t i = 0; i < reg->count; i++)
+  {
+    size_t name_len;
+    if (cli_registry_bucket(reg, reg->commands[i]->command, &name_len) != bucket)
+      continue;
+    size_t slot = cli_registry_slot(reg, reg->commands[i]->command, seed);
+    if (reg->slots[slot] != 0)
+    { /* Collision. Undo this bucket's placements */
+      for (size_t j = 0; (j < i) && (placed > 0); j++)
+      {
+        if (cli_registry_bucket(reg, reg->commands[j]->command, &name_len) != bucket)
+          continue;
+        size_t undo = cli_registry_slot(reg, reg->commands[j]->command, seed);
+        if (reg->slots[undo] == (uint16_t)(j + 1))
+        {
+          reg->slots[undo] = 0;
+          placed--;
+        }
+      }
+      return false;
+    }
+    reg->slots[slot] = (uint16_t)(i + 1);
+    placed++;
+  }
+  return true;
+}
+
+/*
+  Build the perfect hash (hash and displace). Buckets are placed largest first, each bucket
+  searching for a seed that puts all of its commands into free slots. Up to
+  O(count * buckets * 256) without needing any scratch memory, so call this at init after
+  registering the commands. Does nothing if the hash is already built (or already failed)
+  for the current command set.
+*/
+static inline bool cli_registry_build(cli_registry_t *reg)
+{
+  if (reg->hash_valid || reg->hash_failed)
+    return reg->hash_valid;
+
+  memset(reg->slots, 0, reg->slot_count * sizeof(reg->slots[0]));
+  memset(reg->seeds, 0, reg->bucket_count * sizeof(reg->seeds[0]));
+
+  /* Largest bucket size */
+  size_t max_bucket_size = 0;
+  for (size_t b = 0; b < reg->bucket_count; b++)
+  {
+    size_t size = 0;
+    for (size_t i = 0; i < reg->count; i++)
+    {
+      size_t name_len;
+      size += (cli_registry_bucket(reg, reg->commands[i]->command, &name_len) == b);
+    }
+    if (size > max_bucket_size)
+      max_bucket_size = size;
+  }
+
+  for (size_t target = max_bucket_size; target > 0; target--)
+  {
+    for (size_t b = 0; b < reg->bucket_count; b++)
+    {
+      size_t size = 0;
+      for (size_t i = 0; i < reg->count; i++)
+      {
+        size_t name_len;
+        size += (cli_registry_bucket(reg, reg->commands[i]->command, &name_len) == b);
+      }
+      if (size != target)
+        continue;
+
+      unsigned seed = 0;
+      while ((seed <= UINT8_MAX) && !cli_registry_place_bucket(reg, b, (uint8_t)seed))
+        seed++;
+      if (seed > UINT8_MAX)
+      {
+        reg->hash_failed = true;
+        return false; ///< Failed: No seed found (try more slots or buckets)
+      }
+      reg->seeds[b] = (uint8_t)seed;
+    }
+  }
+
+  reg->hash_valid = true;
+  reg->hash_failed = false;
+  return true; ///< Successful
+}
+
+
+/*******************************************************************************
+ * Lookup/Dispatch
+*******************************************************************************/
+
+static inline bool cli_registry_name_matches(const cli_command_t *command, const char *name, size_t name_len)
+{
+  return (strncmp(command->command, name, name_len) == 0) && (command->command[name_len] == '\0');
+}
+
+/* Find a command by name. `name` may be a whole command line (name ends at whitespace) */
+static inline const cli_command_t *cli_registry_find(cli_registry_t *reg, const char *name)
+{
+  if (reg->count == 0)
+    return NULL;
+  if (!reg->hash_valid && !reg->hash_failed)
+    cli_registry_build(reg); ///< Fallback, if not built at init (or registered since)
+
+  size_t name_len;
+  const size_t bucket = cli_registry_bucket(reg, name, &name_len);
+  if (!reg->hash_valid)
+  { /* No perfect hash for this command set. Still find the command, the slow way */
+    for (size_t i = 0; i < reg->count; i++)
+    {
+      if (cli_registry_name_matches(reg->commands[i], name, name_len))
+        return reg->commands[i];
+    }
+    return NULL; ///< Not a registered command
+  }
+
+  const uint16_t entry = reg->slots[cli_registry_slot(reg, name, reg->seeds[bucket])];
+  if (entry == 0)
+    return NULL;
+
+  const cli_command_t *command = reg->commands[entry - 1];
+  if (!cli_registry_name_matches(command, name, name_len))
+    return NULL; ///< Not a registered command
+  return command;
+}
+
+/* Look up the first word of the command line and run its handler */
+static inline bool cli_registry_process(cli_registry_t *reg, const char *command_string, char *write_buffer, size_t write_buffer_len)
+{
+  const cli_command_t *command = cli_registry_find(reg, command_string);
+  if ((command == NULL) || (command->handler == NULL))
+  {
+    if (write_buffer_len > 0)
+      snprintf(write_buffer, write_buffer_len, "Command not recognised.\r\n");
+    return false;
+  }
+  return command->handler(write_buffer, write_buffer_len, command_string);
+}
+
+
+/*******************************************************************************
+ * Help (Registration Order)
+*******************************************************************************/
+
+static inline size_t cli_registry_count(const cli_registry_t *reg)
+{
+  return reg->count;
+}
+
+static inline const cli_command_t *cli_registry_get(const cli_registry_t *reg, size_t index)
+{
+  return (index < reg->count) ? reg->commands[index] : NULL;
+}
+
+/* Render all commands into a help table, if the registry changed since it was last built */
+static inline bool cli_registry_update_help_table(const cli_registry_t *reg, help_table_t *t)
+{
+  if (!help_table_is_stale(t, reg->generation))
+    return true; ///< Already up to date
+
+  help_table_begin(t);
+  for (size_t i = 0; i < reg->count; i++)
+  {
+    if (!help_table_add(t, reg->commands[i]->command, reg->commands[i]->help_string))
+      return false; ///< Failed: Help table too small
+  }
+  help_table_end(t, reg->generation);
+  return true; ///< Successful
+}
+
+
+#ifdef DEMO
+static bool demo_echo_handler(char *write_buffer, size_t write_buffer_len, const char *command_string)
+{
+  snprintf(write_buffer, write_buffer_len, "echo handler got '%s'\r\n", command_string);
+  return true;
+}
+
+int main(void)
+{
+  static const cli_command_t demo_commands[] = {
+    {"echo",  "... <text>: Echo text back\r\n", demo_echo_handler},
+    {"read",  "... <addr>: Read a register\r\n", NULL},
+    {"write", "... <addr> <value>: Write a value to a register\r\n", NULL},
+    {"reset", "... : Reset the device\r\n", NULL},
+  };
+
+  static const cli_command_t *commands[256];
+  static uint16_t slots[512];
+  static uint8_t seeds[256];
+  cli_registry_t reg;
+  cli_registry_init(&reg, commands, sizeof(commands)/sizeof(commands[0]), slots, sizeof(slots)/sizeof(slots[0]), seeds, sizeof(seeds)/sizeof(seeds[0]));
+
+  for (size_t i = 0; i < (sizeof(demo_commands)/sizeof(demo_commands[0])); i++)
+  {
+    cli_registry_register(&reg, &demo_commands[i]);
+  }
+
+  /* Pad out the registry to a realistic size */
+  static cli_command_t filler[200];
+  static char filler_names[200][16];
+  for (size_t i = 0; i < 200; i++)
+  {
+    snprintf(filler_names[i], sizeof(filler_names[i]), "cmd%zu", i);
+    filler[i].command = filler_names[i];
+    filler[i].help_string = "... : Filler command\r\n";
+    cli_registry_register(&reg, &filler[i]);
+  }
+
+  /* Build once at init, so the first command typed does not pay for it */
+  bool ok = cli_registry_build(&reg);
+
+  /* Every registered name must resolve to itself */
+  for (size_t i = 0; ok && (i < cli_registry_count(&reg)); i++)
+  {
+    ok = (cli_registry_find(&reg, cli_registry_get(&reg, i)->command) == cli_registry_get(&reg, i));
+  }
+  ok = ok && (cli_registry_find(&reg, "ech") == NULL) && (cli_registry_find(&reg, "echoo") == NULL) && (cli_registry_find(&reg, "cmd200") == NULL);
+  printf("perfect hash over %zu commands : %s\n", cli_registry_count(&reg), ok ? "all lookups ok" : "LOOKUP FAILED");
+
+  /* Duplicate names are refused (no hash could tell them apart) */
+  const bool dup_refused = !cli_registry_register(&reg, &demo_commands[0]) && (cli_registry_count(&reg) == 204);
+  printf("duplicate registration : %s\n", dup_refused ? "refused" : "ACCEPTED");
+  ok = ok && dup_refused;
+
+  /* Too few slots and buckets for a perfect hash: build fails once, lookups fall back to a linear scan */
+  {
+    static const cli_command_t *small_commands[16];
+    static uint16_t small_slots[16];
+    static uint8_t small_seeds[1];
+    cli_registry_t small = cli_registry_struct_prefill(small_commands, small_slots, small_seeds);
+    for (size_t i = 0; i < 16; i++)
+      cli_registry_register(&small, &filler[i]);
+    bool small_ok = !cli_registry_build(&small);
+    for (size_t i = 0; small_ok && (i < 16); i++)
+      small_ok = (cli_registry_find(&small, filler[i].command) == &filler[i]) && small.hash_failed;
+    small_ok = small_ok && (cli_registry_find(&small, "cmd16") == NULL);
+    printf("no perfect hash over %zu commands : %s\n", cli_registry_count(&small), small_ok ? "linear scan lookups ok" : "LOOKUP FAILED");
+    ok = ok && small_ok;
+  }
+
+  char out[128];
+  cli_registry_process(&reg, "echo hello world", out, sizeof(out));
+  printf("%s", out);
+  cli_registry_process(&reg, "bogus", out, sizeof(out));
+  printf("%s", out);
+
+  /* Help served from the registry in registration order */
+  static char help_arena[16 * 1024];
+  static help_table_entry_t help_entries[256];
+  help_table_t help_table = help_table_struct_prefill(help_arena, help_entries, 4, 8);
+  cli_registry_update_help_table(&reg, &help_table);
+  for (size_t i = 0; i < 5; i++)
+  {
+    char line[80];
+    help_table_copy(&help_table, i, line, sizeof(line));
+    printf("%s", line);
+  }
+
+  return !ok;
+}
+#endif //DEMO
@@ -0,0 +1,710 @@
+//usr/bin/clang -DDEMO "$0" && exec ./a.out "$@"
+
+/*
+  Zero copy COBS and SLIP packet framing on top of the circular byte buffer.
+
+  Encoders write the framed packet straight into the ring's free space
+  (`circularBuffer_uint8_WriteSpan()`) and only make it readable with a single
+  `circularBuffer_uint8_Commit()` once the whole frame fits, so a UART TX
+  interrupt never sees half a frame and a full ring never gets a partial one.
+  The runs between bytes that need special handling (a COBS zero, a SLIP END or
+  ESC) are found with memchr() and copied in one go.
+
+  Decoders work on the ring's readable spans (`circularBuffer_uint8_ReadSpan()`)
+  and decode in one pass into the caller's frame buffer, using memchr() to skip
+  to the next delimiter or escape. State is kept between calls, so a frame can
+  arrive over any number of RX interrupts.
+
+  ```
+  static uint8_t rxBuff[256];
+  static circularBuffer_uint8_t rx = circularBuffer_uint8_struct_prefill(rxBuff);
+  static uint8_t frame[128];
+  static cobs_decoder_t dec = cobs_decoder_struct_prefill(frame);
+
+  size_t frameLen = 0;
+  while (cobs_decode_from_ring(&dec, &rx, &frameLen))
+    handle_packet(frame, frameLen);
+  ```
+
+  COBS: Consistent Overhead Byte Stuffing (Cheshire & Baker), 0x00 delimited.
+  SLIP: RFC 1055, 0xC0 delimited with 0xDB escapes.
+
+  Unit Test: clang -DTEST cobsSlipFraming.c && ./a.out
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Reuse the ring without its unit test main */
+#pragma push_macro("TEST")
+#undef TEST
+#include "circularByteBuff_ptrBased.c"
+#pragma pop_macro("TEST")
+
+#define COBS_DELIMITER 0x00
+#define COBS_MAX_BLOCK 254 ///< Data bytes in a block with code 0xFF (no implied zero after it)
+
+#define SLIP_END      0xC0
+#define SLIP_ESC      0xDB
+#define SLIP_ESC_END  0xDC
+#define SLIP_ESC_ESC  0xDD
+
+
+/*******************************************************************************
+ * Ring Writer (Uncommitted writes into the free space of the ring)
+*******************************************************************************/
+
+typedef struct framing_writer_t
+{
+  circularBuffer_uint8_t *cb; ///< Ring being written into
+  size_t offset;              ///< Bytes written past the tail (not committed yet)
+  uint8_t *span;              ///< Current contiguous free space
+  size_t spanLen;             ///< Bytes left in `span`
+  bool overflow;              ///< Ran out of free space, frame will not be committed
+} framing_writer_t;
+
+static inline void framing_writer_init(framing_writer_t *w, circularBuffer_uint8_t *cb)
+{
+  w->cb = cb;
+  w->offset = 0;
+  w->span = NULL;
+  w->spanLen = 0;
+  w->overflow = false;
+}
+
+static inline bool framing_writer_refill(framing_writer_t *w)
+{
+  if (w->overflow || !circularBuffer_uint8_WriteSpan(w->cb, w->offset, &w->span, &w->spanLen))
+  {
+    w->overflow = true;
+    w->spanLen = 0;
+    return false; ///< Failed
+  }
+  return true; ///< Successful
+}
+
+static inline void framing_put_byte(framing_writer_t *w, uint8_t b)
+{
+  if ((w->spanLen == 0) && !framing_writer_refill(w))
+    return;
+  *w->span = b;
+  w->span++;
+  w->spanLen--;
+  w->offset++;
+}
+
+static inline void framing_put(framing_writer_t *w, const uint8_t *data, size_t len)
+{
+  while (len > 0)
+  {
+    if ((w->spanLen == 0) && !framing_writer_refill(w))
+      return;
+    const size_t n = (len < w->spanLen) ? len : w->spanLen;
+    memcpy(w->span, data, n);
+    w->span += n;
+    w->spanLen -= n;
+    w->offset += n;
+    data += n;
+    len -= n;
+  }
+}
+
+/* Make the whole frame readable, or drop it if it did not fit */
+static inline bool framing_writer_commit(framing_writer_t *w)
+{
+  if (w->overflow)
+    return false; ///< Failed: Ring full, nothing was enqueued
+  return circularBuffer_uint8_Commit(w->cb, w->offset);
+}
+
+
+/*******************************************************************************
+ * COBS
+*******************************************************************************/
+
+/* Encode `data` as one COBS frame (including the trailing 0x00) straight into the ring */
+bool cobs_encode_to_ring(circularBuffer_uint8_t *cb, const uint8_t *data, size_t len)
+{
+  framing_writer_t w;
+  framing_writer_init(&w, cb);
+
+  if (len == 0)
+  { /* Empty packet is a single empty block (and `data` may be NULL) */
+    framing_put_byte(&w, 0x01);
+    framing_put_byte(&w, COBS_DELIMITER);
+    return framing_writer_commit(&w);
+  }
+
+  for (;;)
+  {
+    /* Each block is a code byte (run length + 1) then a run of non zero bytes */
+    const size_t limit = (len < COBS_MAX_BLOCK) ? len : COBS_MAX_BLOCK;
+    const uint8_t *zero = memchr(data, 0x00, limit);
+    const size_t run = zero ? (size_t)(zero - data) : limit;
+    framing_put_byte(&w, (uint8_t)(run + 1));
+    framing_put(&w, data, run);
+    if (w.overflow)
+      return false; ///< Failed: Ring full, nothing was enqueued
+    data += run;
+    len -= run;
+    if (run == COBS_MAX_BLOCK)
+    { /* Full block has no implied zero, carry on with the next one (if any) */
+      if (len == 0)
+        break;
+      continue;
+    }
+    if (len == 0)
+      break;
+    /* Skip the zero the block stands for. If it was the last byte, an empty block follows */
+    data++;
+    len--;
+  }
+
+  framing_put_byte(&w, COBS_DELIMITER);
+  return framing_writer_commit(&w);
+}
+
+// Prefill COBS Decoder (Allows for skipping `cobs_decoder_init()`)
+#define cobs_decoder_struct_prefill(Buff) \
+{                                         \
+  .frame        = &Buff[0],               \
+  .frame_size   = sizeof(Buff),           \
+  .frame_len    = 0,                      \
+  .block_left   = 0,                      \
+  .zero_pending = false,                  \
+  .started      = false,                  \
+  .error        = false,                  \
+  .errors       = 0                       \
+}
+
+typedef struct cobs_decoder_t
+{
+  uint8_t *frame;     ///< Caller's buffer the frame is decoded into
+  size_t frame_size;  ///< Size of `frame`
+  size_t frame_len;   ///< Bytes decoded into `frame` so far
+  uint8_t block_left; ///< Data bytes left in the current block
+  bool zero_pending;  ///< Current block ends with an implied zero (added if another block follows)
+  bool started;       ///< Read the first code byte of this frame
+  bool error;         ///< Frame too big or malformed, skip to the next delimiter
+  uint32_t errors;    ///< Frames dropped
+} cobs_decoder_t;
+
+static inline void cobs_decoder_init(cobs_decoder_t *dec, uint8_t *frame, size_t frame_size)
+{
+  dec->frame = frame;
+  dec->frame_size = frame_size;
+  dec->frame_len = 0;
+  dec->block_left = 0;
+  dec->zero_pending = false;
+  dec->started = false;
+  dec->error = false;
+  dec->errors = 0;
+}
+
+static inline void cobs_decoder_next_frame(cobs_decoder_t *dec)
+{
+  dec->frame_len = 0;
+  dec->block_left = 0;
+  dec->zero_pending = false;
+  dec->started = false;
+  dec->error = false;
+}
+
+static inline void cobs_decoder_put(cobs_decoder_t *dec, const uint8_t *data, size_t len)
+{
+  if (dec->error)
+    return;
+  if ((dec->frame_size - dec->frame_len) < len)
+  {
+    dec->error = true; ///< Frame bigger than the caller's buffer
+    return;
+  }
+  memcpy(&dec->frame[dec->frame_len], data, len);
+  dec->frame_len += len;
+}
+
+/*
+  Decode from a chunk of encoded bytes, stopping just after a frame delimiter.
+  `*used` is set to the bytes consumed. Returns true with `*frameLen` set when
+  a good frame is in `dec->frame` (it stays there until the next call).
+*/
+bool cobs_decode_chunk(cobs_decoder_t *dec, const uint8_t *chunk, size_t len, size_t *used, size_t *frameLen)
+{
+  size_t i = 0;
+  while (i < len)
+  {
+    if (dec->block_left == 0)
+    { /* Code byte (or the delimiter) */
+      const uint8_t code = chunk[i++];
+      if (code == COBS_DELIMITER)
+      {
+        const bool good = dec->started && !dec->error;
+        if (dec->started && dec->error)
+          dec->errors++;
+        *frameLen = dec->frame_len;
+        cobs_decoder_next_frame(dec);
+        if (good)
+        {
+          *used = i;
+          return true; ///< Successful
+        }
+        continue; ///< Idle fill or dropped frame
+      }
+      if (dec->zero_pending)
+      {
+        const uint8_t zero = 0x00;
+        cobs_decoder_put(dec, &zero, 1);
+      }
+      dec->started = true;
+      dec->block_left = (uint8_t)(code - 1);
+      dec->zero_pending = (code != 0xFF);
+      continue;
+    }
+
+    /* Block data: copy up to the end of the block, but a zero here means a cut short frame */
+    size_t take = ((len - i) < dec->block_left) ? (len - i) : dec->block_left;
+    const uint8_t *zero = memchr(&chunk[i], COBS_DELIMITER, take);
+    if (zero)
+      take = (size_t)(zero - &chunk[i]);
+    cobs_decoder_put(dec, &chunk[i], take);
+    i += take;
+    dec->block_left = (uint8_t)(dec->block_left - take);
+    if (zero)
+    {
+      dec->error = true;
+      dec->block_left = 0; ///< Let the delimiter end (and drop) this frame
+    }
+  }
+  *used = i;
+  return false; ///< Need more bytes
+}
+
+/* Pull the next complete frame out of the ring. Returns false when more bytes are needed */
+bool cobs_decode_from_ring(cobs_decoder_t *dec, circularBuffer_uint8_t *cb, size_t *frameLen)
+{
+  const uint8_t *span = NULL;
+  size_t spanLen = 0;
+  size_t used = 0;
+  while (circularBuffer_uint8_ReadSpan(cb, &span, &spanLen))
+  {
+    const bool frameDone = cobs_decode_chunk(dec, span, spanLen, &used, frameLen);
+    circularBuffer_uint8_Discard(cb, used);
+    if (frameDone)
+      return true; ///< Successful
+  }
+  return false; ///< Need more bytes
+}
+
+
+/*******************************************************************************
+ * SLIP
+*******************************************************************************/
+
+/* Encode `data` as one SLIP frame (END, data, END) straight into the ring */
+bool slip_encode_to_ring(circularBuffer_uint8_t *cb, const uint8_t *data, size_t len)
+{
+  framing_writer_t w;
+  framing_writer_init(&w, cb);
+
+  framing_put_byte(&w, SLIP_END); ///< Flushes any line noise in the receiver (RFC 1055)
+  if (len > 0)
+  {
+    const uint8_t *p = data;
+    const uint8_t *const dataEnd = data + len;
+    const uint8_t *nextEnd = memchr(p, SLIP_END, len);
+    const uint8_t *nextEsc = memchr(p, SLIP_ESC, len);
+    for (;;)
+    {
+      /* memchr() for the next END and ESC, each only rescanned once the run has passed it */
+      if (nextEnd && (nextEnd < p))
+        nextEnd = memchr(p, SLIP_END, (size_t)(dataEnd - p));
+      if (nextEsc && (nextEsc < p))
+        nextEsc = memchr(p, SLIP_ESC, (size_t)(dataEnd - p));
+      const uint8_t *stop = dataEnd;
+      if (nextEnd && (nextEnd < stop))
+        stop = nextEnd;
+      if (nextEsc && (nextEsc < stop))
+        stop = nextEsc;
+
+      /* Copy the run up to the next byte that needs escaping in one go */
+      framing_put(&w, p, (size_t)(stop - p));
+      if (stop == dataEnd)
+        break;
+      framing_put_byte(&w, SLIP_ESC);
+      framing_put_byte(&w, (*stop == SLIP_END) ? SLIP_ESC_END : SLIP_ESC_ESC);
+      p = stop + 1;
+    }
+  }
+  framing_put_byte(&w, SLIP_END);
+  return framing_writer_commit(&w);
+}
+
+// Prefill SLIP Decoder (Allows for skipping `slip_decoder_init()`)
+#define slip_decoder_struct_prefill(Buff) \
+{                                         \
+  .frame        = &Buff[0],               \
+  .frame_size   = sizeof(Buff),           \
+  .frame_len    = 0,                      \
+  .escaped      = false,                  \
+  .error        = false,                  \
+  .errors       = 0                       \
+}
+
+typedef struct slip_decoder_t
+{
+  uint8_t *frame;    ///< Caller's buffer the frame is decoded into
+  size_t frame_size; ///< Size of `frame`
+  size_t frame_len;  ///< Bytes decoded into `frame` so far
+  bool escaped;      ///< Last byte was SLIP_ESC
+  bool error;        ///< Frame too big or bad escape, skip to the next END
+  uint32_t errors;   ///< Frames dropped
+} slip_decoder_t;
+
+static inline void slip_decoder_init(slip_decoder_t *dec, uint8_t *frame, size_t frame_size)
+{
+  dec->frame = frame;
+  dec->frame_size = frame_size;
+  dec->frame_len = 0;
+  dec->escaped = false;
+  dec->error = false;
+  dec->errors = 0;
+}
+
+static inline void slip_decoder_next_frame(slip_decoder_t *dec)
+{
+  dec->frame_len = 0;
+  dec->escaped = false;
+  dec->error = false;
+}
+
+static inline void slip_decoder_put(slip_decoder_t *dec, const uint8_t *data, size_t len)
+{
+  if (dec->error)
+    return;
+  if ((dec->frame_size - dec->frame_len) < len)
+  {
+    dec->error = true; ///< Frame bigger than the caller's buffer
+    return;
+  }
+  memcpy(&dec->frame[dec->frame_len], data, len);
+  dec->frame_len += len;
+}
+
+/*
+  Decode from a chunk of encoded bytes, stopping just after a frame's END.
+  `*used` is set to the bytes consumed. Returns true with `*frameLen` set when
+  a good frame is in `dec->frame` (it stays there until the next call).
+*/
+bool slip_decode_chunk(slip_decoder_t *dec, const uint8_t *chunk, size_t len, size_t *used, size_t *frameLen)
+{
+  size_t i = 0;
+  while (i < len)
+  {
+    if (dec->escaped && (chunk[i] != SLIP_END))
+    {
+      const uint8_t b = (chunk[i] == SLIP_ESC_END) ? SLIP_END : SLIP_ESC;
+      if ((chunk[i] != SLIP_ESC_END) && (chunk[i] != SLIP_ESC_ESC))
+        dec->error = true; ///< Protocol violation
+      slip_decoder_put(dec, &b, 1);
+      dec->escaped = false;
+      i++;
+      continue;
+    }
+
+    /* Copy the run up to the next END or ESC in one go */
+    const uint8_t *end = memchr(&chunk[i], SLIP_END, len - i);
+    const size_t endPos = end ? (size_t)(end - chunk) : len;
+    const uint8_t *esc = memchr(&chunk[i], SLIP_ESC, endPos - i);
+    const size_t stop = esc ? (size_t)(esc - chunk) : endPos;
+    slip_decoder_put(dec, &chunk[i], stop - i);
+    i = stop;
+    if (esc)
+    {
+      dec->escaped = true;
+      i++;
+      continue;
+    }
+    if (end)
+    {
+      i++;
+      if (dec->escaped)
+        dec->error = true; ///< ESC then END
+      if (dec->error)
+        dec->errors++;
+      const bool good = !dec->error && (dec->frame_len > 0); ///< Empty frames (back to back END) are skipped
+      *frameLen = dec->frame_len;
+      slip_decoder_next_frame(dec);
+      if (good)
+      {
+        *used = i;
+        return true; ///< Successful
+      }
+    }
+  }
+  *used = i;
+  return false; ///< Need more bytes
+}
+
+/* Pull the next complete frame out of the ring. Returns false when more bytes are needed */
+bool slip_decode_from_ring(slip_decoder_t *dec, circularBuffer_uint8_t *cb, size_t *frameLen)
+{
+  const uint8_t *span = NULL;
+  size_t spanLen = 0;
+  size_t used = 0;
+  while (circularBuffer_uint8_ReadSpan(cb, &span, &spanLen))
+  {
+    const bool frameDone = slip_decode_chunk(dec, span, spanLen, &used, frameLen);
+    circularBuffer_uint8_Discard(cb, used);
+    if (frameDone)
+      return true; ///< Successful
+  }
+  return false; ///< Need more bytes
+}
+
+
+#ifdef DEMO
+static void demo_print_ring(const char *label, circularBuffer_uint8_t *cb)
+{
+  printf("%s:", label);
+  for (size_t i = 0 ; i < circularBuffer_uint8_Count(cb) ; i++)
+  {
+    uint8_t b = 0;
+    circularBuffer_uint8_Peek(cb, &b, i);
+    printf(" %02X", b);
+  }
+  printf("\n");
+}
+
+int main(void)
+{
+  static uint8_t linkBuff[32];
+  circularBuffer_uint8_t link = circularBuffer_uint8_struct_prefill(linkBuff);
+  static uint8_t frame[16];
+  cobs_decoder_t cobs = cobs_decoder_struct_prefill(frame);
+  slip_decoder_t slip = slip_decoder_struct_prefill(frame);
+  const uint8_t packet[] = {0x11, 0x22, 0x00, 0x33, 0xC0, 0xDB};
+  size_t frameLen = 0;
+
+  cobs_encode_to_ring(&link, packet, sizeof(packet));
+  demo_print_ring("COBS", &link);
+  while (cobs_decode_from_ring(&cobs, &link, &frameLen))
+    printf("COBS frame of %zu bytes, match:%d\n", frameLen, (frameLen == sizeof(packet)) && !memcmp(frame, packet, frameLen));
+
+  slip_encode_to_ring(&link, packet, sizeof(packet));
+  demo_print_ring("SLIP", &link);
+  while (slip_decode_from_ring(&slip, &link, &frameLen))
+    printf("SLIP frame of %zu bytes, match:%d\n", frameLen, (frameLen == sizeof(packet)) && !memcmp(frame, packet, frameLen));
+  return 0;
+}
+#endif //DEMO
+
+#ifdef TEST
+/*******************************************************************************
+ * Mini Unit Test Of Framing
+*******************************************************************************/
+
+// Minimum Assert Unit (https://jera.com/techinfo/jtns/jtn002)
+#define mu_assert(message, test) do { if (!(test)) return LINEINFO " : (expect:" #test ") " message; } while (0)
+#define mu_run_test(test) do { char *message = test(); if (message) return message; } while (0)
+
+// Line Info (Ref: __LINE__ to string http://decompile.com/cpp/faq/file_and_line_error_string.htm)
+#define LINEINFO_STR(X) #X
+#define LINEINFO__STR(X) LINEINFO_STR(X)
+#define LINEINFO __FILE__ " : " LINEINFO__STR(__LINE__)
+
+static uint32_t test_rand(void)
+{
+  static uint32_t x = 2463534242u;
+  x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+  return x;
+}
+
+static bool test_ring_equals(circularBuffer_uint8_t *cb, const uint8_t *expect, size_t len)
+{
+  if (circularBuffer_uint8_Count(cb) != len)
+    return false;
+  for (size_t i = 0 ; i < len ; i++)
+  {
+    uint8_t b = 0;
+    circularBuffer_uint8_Peek(cb, &b, i);
+    if (b != expect[i])
+      return false;
+  }
+  return true;
+}
+
+char * framing_test_cobs_vectors(void)
+{
+  /* Examples from the COBS paper / Wikipedia */
+  static uint8_t ringBuff[300];
+  circularBuffer_uint8_t ring = circularBuffer_uint8_struct_prefill(ringBuff);
+  static uint8_t in[300];
+  static uint8_t expect[300];
+  {
+    const uint8_t a[] = {0x00};
+    const uint8_t e[] = {0x01, 0x01, 0x00};
+    mu_assert("", cobs_encode_to_ring(&ring, a, sizeof(a)) && test_ring_equals(&ring, e, sizeof(e)));
+    circularBuffer_uint8_Reset(&ring);
+  }
+  {
+    const uint8_t a[] = {0x11, 0x22, 0x00, 0x33};
+    const uint8_t e[] = {0x03, 0x11, 0x22, 0x02, 0x33, 0x00};
+    mu_assert("", cobs_encode_to_ring(&ring, a, sizeof(a)) && test_ring_equals(&ring, e, sizeof(e)));
+    circularBuffer_uint8_Reset(&ring);
+  }
+  {
+    const uint8_t a[] = {0x11, 0x00, 0x00, 0x00};
+    const uint8_t e[] = {0x02, 0x11, 0x01, 0x01, 0x01, 0x00};
+    mu_assert("", cobs_encode_to_ring(&ring, a, sizeof(a)) && test_ring_equals(&ring, e, sizeof(e)));
+    circularBuffer_uint8_Reset(&ring);
+  }
+  {
+    const uint8_t e[] = {0x01, 0x00};
+    mu_assert("", cobs_encode_to_ring(&ring, in, 0) && test_ring_equals(&ring, e, sizeof(e)));
+    circularBuffer_uint8_Reset(&ring);
+    mu_assert("", cobs_encode_to_ring(&ring, NULL, 0) && test_ring_equals(&ring, e, sizeof(e)));
+    circularBuffer_uint8_Reset(&ring);
+  }
+  /* 01..FE: one full block, no trailing empty block */
+  for (int i = 0 ; i < 254 ; i++)
+    in[i] = (uint8_t)(i + 1);
+  expect[0] = 0xFF;
+  memcpy(&expect[1], in, 254);
+  expect[255] = 0x00;
+  mu_assert("", cobs_encode_to_ring(&ring, in, 254) && test_ring_equals(&ring, expect, 256));
+  circularBuffer_uint8_Reset(&ring);
+  /* 01..FF: full block then a block holding FF */
+  in[254] = 0xFF;
+  expect[255] = 0x02;
+  expect[256] = 0xFF;
+  expect[257] = 0x00;
+  mu_assert("", cobs_encode_to_ring(&ring, in, 255) && test_ring_equals(&ring, expect, 258));
+  return 0;
+}
+
+char * framing_test_slip_vectors(void)
+{
+  static uint8_t ringBuff[16];
+  circularBuffer_uint8_t ring = circularBuffer_uint8_struct_prefill(ringBuff);
+  const uint8_t a[] = {0x01, SLIP_END, 0x02, SLIP_ESC};
+  const uint8_t e[] = {SLIP_END, 0x01, SLIP_ESC, SLIP_ESC_END, 0x02, SLIP_ESC, SLIP_ESC_ESC, SLIP_END};
+  mu_assert("", slip_encode_to_ring(&ring, a, sizeof(a)) && test_ring_equals(&ring, e, sizeof(e)));
+  circularBuffer_uint8_Reset(&ring);
+  /* Runs between, before and after escapes (each of END and ESC found again after the other) */
+  const uint8_t b[] = {SLIP_ESC, SLIP_ESC, 0x03, SLIP_END, 0x04, SLIP_ESC, 0x05};
+  const uint8_t f[] = {SLIP_END, SLIP_ESC, SLIP_ESC_ESC, SLIP_ESC, SLIP_ESC_ESC, 0x03, SLIP_ESC, SLIP_ESC_END, 0x04, SLIP_ESC, SLIP_ESC_ESC, 0x05, SLIP_END};
+  mu_assert("", slip_encode_to_ring(&ring, b, sizeof(b)) && test_ring_equals(&ring, f, sizeof(f)));
+  circularBuffer_uint8_Reset(&ring);
+  const uint8_t g[] = {SLIP_END, SLIP_END};
+  mu_assert("", slip_encode_to_ring(&ring, NULL, 0) && test_ring_equals(&ring, g, sizeof(g)));
+  return 0;
+}
+
+char * framing_test_ring_full(void)
+{
+  /* A frame that does not fit leaves the ring untouched */
+  static uint8_t ringBuff[8];
+  circularBuffer_uint8_t ring = circularBuffer_uint8_struct_prefill(ringBuff);
+  const uint8_t a[] = {1, 2, 3, 4, 5, 6, 7};
+  mu_assert("", !cobs_encode_to_ring(&ring, a, 7));
+  mu_assert("", circularBuffer_uint8_IsEmpty(&ring));
+  mu_assert("", cobs_encode_to_ring(&ring, a, 6));
+  mu_assert("", circularBuffer_uint8_IsFull(&ring));
+  mu_assert("", !slip_encode_to_ring(&ring, a, 1));
+  mu_assert("", circularBuffer_uint8_IsFull(&ring));
+  return 0;
+}
+
+char * framing_test_roundtrip(void)
+{
+  /* Odd sized ring so frames wrap at every point; RX side is fed in random sized pieces */
+  static uint8_t txBuff[1021];
+  static uint8_t rxBuff[97];
+  circularBuffer_uint8_t tx = circularBuffer_uint8_struct_prefill(txBuff);
+  circularBuffer_uint8_t rx = circularBuffer_uint8_struct_prefill(rxBuff);
+  static uint8_t frame[600];
+  cobs_decoder_t cobs = cobs_decoder_struct_prefill(frame);
+  slip_decoder_t slip = slip_decoder_struct_prefill(frame);
+  static uint8_t packet[600];
+  for (int round = 0 ; round < 4000 ; round++)
+  {
+    const bool useCobs = (round & 1);
+    const size_t len = test_rand() % ((round % 7) ? 40 : 600);
+    for (size_t i = 0 ; i < len ; i++)
+    { /* Plenty of delimiter and escape bytes */
+      const uint32_t r = test_rand();
+      packet[i] = (r & 3) ? (uint8_t)(r >> 8) : ((r & 4) ? 0x00 : SLIP_END);
+    }
+    mu_assert("", useCobs ? cobs_encode_to_ring(&tx, packet, len) : slip_encode_to_ring(&tx, packet, len));
+
+    size_t frameLen = 0;
+    bool gotFrame = false;
+    while (!circularBuffer_uint8_IsEmpty(&tx) || !circularBuffer_uint8_IsEmpty(&rx))
+    {
+      /* Move a random sized piece across the "UART" */
+      uint8_t b = 0;
+      size_t piece = 1 + (test_rand() % 13);
+      while (piece-- && !circularBuffer_uint8_IsFull(&rx) && circularBuffer_uint8_Dequeue(&tx, &b))
+        circularBuffer_uint8_Enqueue(&rx, b);
+      if (useCobs ? cobs_decode_from_ring(&cobs, &rx, &frameLen) : slip_decode_from_ring(&slip, &rx, &frameLen))
+      {
+        mu_assert("", !gotFrame);
+        mu_assert("", (frameLen == len) && (memcmp(frame, packet, len) == 0));
+        gotFrame = true;
+      }
+    }
+    mu_assert("", gotFrame || (!useCobs && (len == 0))); // SLIP skips empty frames
+  }
+  mu_assert("", (cobs.errors == 0) && (slip.errors == 0));
+  return 0;
+}
+
+char * framing_test_errors(void)
+{
+  static uint8_t rxBuff[64];
+  circularBuffer_uint8_t rx = circularBuffer_uint8_struct_prefill(rxBuff);
+  static uint8_t frame[4];
+  cobs_decoder_t cobs = cobs_decoder_struct_prefill(frame);
+  slip_decoder_t slip = slip_decoder_struct_prefill(frame);
+  size_t frameLen = 0;
+
+  /* Cut short COBS frame, then a good one */
+  const uint8_t cutShort[] = {0x05, 0x11, 0x22, 0x00, 0x02, 0x33, 0x00};
+  circularBuffer_uint8_EnqueueBlock(&rx, cutShort, sizeof(cutShort));
+  mu_assert("", cobs_decode_from_ring(&cobs, &rx, &frameLen) && (frameLen == 1) && (frame[0] == 0x33));
+  mu_assert("", cobs.errors == 1);
+
+  /* Frame too big for the buffer, then a good one */
+  const uint8_t big[] = {0x06, 1, 2, 3, 4, 5, 0x00, 0x02, 0x44, 0x00};
+  circularBuffer_uint8_EnqueueBlock(&rx, big, sizeof(big));
+  mu_assert("", cobs_decode_from_ring(&cobs, &rx, &frameLen) && (frameLen == 1) && (frame[0] == 0x44));
+  mu_assert("", cobs.errors == 2);
+
+  /* Bad SLIP escape, then a good one */
+  const uint8_t badEscape[] = {SLIP_END, 0x01, SLIP_ESC, 0x01, SLIP_END, 0x55, SLIP_END};
+  circularBuffer_uint8_EnqueueBlock(&rx, badEscape, sizeof(badEscape));
+  mu_assert("", slip_decode_from_ring(&slip, &rx, &frameLen) && (frameLen == 1) && (frame[0] == 0x55));
+  mu_assert("", slip.errors == 1);
+  mu_assert("", circularBuffer_uint8_IsEmpty(&rx));
+  return 0;
+}
+
+static char * all_tests()
+{
+  mu_run_test(framing_test_cobs_vectors);
+  mu_run_test(framing_test_slip_vectors);
+  mu_run_test(framing_test_ring_full);
+  mu_run_test(framing_test_roundtrip);
+  mu_run_test(framing_test_errors);
+  return 0;
+}
+
+int main(void)
+{
+  char *result = all_tests();
+  printf("%s\n", (result) ? result : "ALL TESTS PASSED\n");
+  return result != 0;
+}
+#endif //TEST
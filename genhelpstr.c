@@ -36,14 +36,27 @@
   write                           : test msg 27
   ```
 
+  Since the help text of a command set rarely changes, `help_table_*()` can
+  render every command once into a single arena (with an offset/length index
+  per command). Each later `help` request is then served by a memcpy rather
+  than reformatting the help string again. The table is only rebuilt when the
+  caller's registry generation counter changes.
+
+  For small write buffers (e.g. FreeRTOS CLI's `pcWriteBuffer`), use
+  `gen_help_str_resumable()`. It returns the number of bytes written and keeps
+  a cursor, so long help text is emitted over several calls without losing the
+  tab alignment or `...` expansion at chunk boundaries.
+
+  Unit Test: clang -DTEST genhelpstr.c && ./a.out
 */
 
 
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
-static char* gen_help_str(
+static inline char* gen_help_str(
     char *buffer, int buffer_len,
     const char* command_str_ptr, const char* help_string_ptr,
     const uint32_t margin_tab_count,
@@ -134,6 +147,269 @@ static char* gen_help_str(
   return buffer;
 }
 
+/*******************************************************************************
+ * Resumable Help String Generator
+*******************************************************************************/
+
+typedef struct gen_help_cursor_t
+{
+  const char *hs_ptr;                ///< Next help string character
+  const char *cn_ptr;                ///< Rest of command name being expanded (NULL if none)
+  const char *span_end;              ///< End of the plain run being copied (NULL until scanned)
+  uint32_t tabs_pending;             ///< Margin tabs still to be written
+  uint32_t char_per_line;            ///< Characters on current line (for tab calc)
+  bool command_printed_on_this_line; ///< '...' already expanded on this line
+  bool margin_aligned_on_this_line;  ///< ':' already aligned on this line
+} gen_help_cursor_t;
+
+static inline void gen_help_cursor_init(gen_help_cursor_t *cursor, const char* help_string_ptr)
+{
+  gen_help_cursor_t empty = {0};
+  *cursor = empty;
+  cursor->hs_ptr = help_string_ptr;
+}
+
+/* True once the whole help string has been written out */
+static inline bool gen_help_cursor_done(const gen_help_cursor_t *cursor)
+{
+  return (*cursor->hs_ptr == '\0') && (cursor->cn_ptr == NULL) && (cursor->tabs_pending == 0);
+}
+
+/*
+  Same formatting as gen_help_str(), but resumes from `cursor` and returns the number of
+  bytes written (excluding null). Call again with the same cursor until gen_help_cursor_done().
+  Unlike gen_help_str(), a ':' or newline directly after '...' is handled like anywhere else.
+*/
+static inline size_t gen_help_str_resumable(
+    char *buffer, size_t buffer_len,
+    gen_help_cursor_t *cursor,
+    const char* command_str_ptr,
+    const uint32_t margin_tab_count,
+    const uint32_t spaces_per_tab
+  )
+{
+  if (buffer_len == 0)
+    return 0;
+
+  char *s = buffer; // Outbuff char pointer
+  char *const s_end = buffer + buffer_len - 1; // Leave room for null
+
+  while (s < s_end)
+  {
+    /* Resume expanding command name */
+    if (cursor->cn_ptr)
+    {
+      size_t len = strlen(cursor->cn_ptr);
+      size_t room = (size_t)(s_end - s);
+      size_t copy = (len < room) ? len : room;
+      memcpy(s, cursor->cn_ptr, copy);
+      s += copy;
+      cursor->char_per_line += copy;
+      cursor->cn_ptr = (copy < len) ? (cursor->cn_ptr + copy) : NULL;
+      continue;
+    }
+
+    /* Resume inserting tabs required to reach the margin */
+    if (cursor->tabs_pending)
+    {
+      size_t room = (size_t)(s_end - s);
+      size_t copy = (cursor->tabs_pending < room) ? cursor->tabs_pending : room;
+      memset(s, '\t', copy);
+      s += copy;
+      cursor->tabs_pending -= (uint32_t)copy;
+      continue;
+    }
+
+    const char *hs_ptr = cursor->hs_ptr;
+    if (*hs_ptr == '\0')
+      break;
+
+    /* Copy span up to the next character that needs special handling. Only rescanned once
+       the cursor has passed the end of the last span, not again for every output chunk */
+    if ((cursor->span_end == NULL) || (cursor->span_end < hs_ptr))
+    {
+      const char *stop_set = cursor->command_printed_on_this_line
+                           ? (cursor->margin_aligned_on_this_line ? "\n" : ":\n")
+                           : (cursor->margin_aligned_on_this_line ? ".\n" : ".:\n");
+      cursor->span_end = hs_ptr + strcspn(hs_ptr, stop_set);
+    }
+    size_t span = (size_t)(cursor->span_end - hs_ptr);
+    if (span > 0)
+    { /* Copy Normally */
+      size_t room = (size_t)(s_end - s);
+      size_t copy = (span < room) ? span : room;
+      memcpy(s, hs_ptr, copy);
+      s += copy;
+      cursor->hs_ptr += copy;
+      cursor->char_per_line += copy;
+      continue;
+    }
+
+    const char c = *hs_ptr;
+    if ('.' == c)
+    { /* Scan for '...' and replace with command name */
+      if (('.' == hs_ptr[1]) && ('.' == hs_ptr[2]))
+      {
+        cursor->hs_ptr += 3;
+        cursor->cn_ptr = command_str_ptr;
+        cursor->command_printed_on_this_line = true;
+      }
+      else
+      {
+        *s++ = *cursor->hs_ptr++;
+        cursor->char_per_line++;
+      }
+    }
+    else if (':' == c)
+    { /* Tab linear */
+      *s++ = *cursor->hs_ptr++;
+      cursor->char_per_line++;
+      cursor->margin_aligned_on_this_line = true;
+
+      // Tab Calc
+      uint32_t curr_tab_n = cursor->char_per_line/spaces_per_tab;
+      if (margin_tab_count > curr_tab_n)
+      {
+        cursor->tabs_pending = margin_tab_count - curr_tab_n;
+      }
+    }
+    else
+    { /* Newline */
+      *s++ = *cursor->hs_ptr++;
+      cursor->char_per_line = 0;
+      cursor->command_printed_on_this_line = false;
+      cursor->margin_aligned_on_this_line = false;
+    }
+  }
+
+  *s = 0;
+  return (size_t)(s - buffer);
+}
+
+
+/*******************************************************************************
+ * Cached Pre-Rendered Help Table
+*******************************************************************************/
+
+typedef struct help_table_entry_t
+{
+  size_t offset; ///< Start of rendered help string in arena
+  size_t length; ///< Length of rendered help string (excluding null)
+} help_table_entry_t;
+
+typedef struct help_table_t
+{
+  char *arena;                  ///< Rendered help strings (null separated)
+  size_t arena_size;            ///< Arena capacity
+  size_t arena_used;            ///< Arena bytes used
+  help_table_entry_t *entries;  ///< Index per command (in registration order)
+  size_t entries_max;           ///< Index capacity
+  size_t entry_count;           ///< Number of commands rendered
+  uint32_t margin_tab_count;    ///< gen_help_str() formatting
+  uint32_t spaces_per_tab;      ///< gen_help_str() formatting
+  uint32_t generation;          ///< Registry generation this table was built from
+  bool valid;                   ///< Table fully built
+} help_table_t;
+
+// Prefill Help Table (Allows for skipping `help_table_init()`)
+#define help_table_struct_prefill(ArenaBuff, EntryBuff, MarginTabCount, SpacesPerTab) \
+{                                                                                     \
+  .arena            = ArenaBuff,                                                      \
+  .arena_size       = sizeof(ArenaBuff),                                              \
+  .entries          = EntryBuff,                                                      \
+  .entries_max      = (sizeof(EntryBuff)/sizeof(EntryBuff[0])),                       \
+  .margin_tab_count = MarginTabCount,                                                 \
+  .spaces_per_tab   = SpacesPerTab                                                    \
+}
+
+static inline bool help_table_init(
+    help_table_t *t,
+    char *arena, size_t arena_size,
+    help_table_entry_t *entries, size_t entries_max,
+    const uint32_t margin_tab_count,
+    const uint32_t spaces_per_tab
+  )
+{
+  if ((t == NULL) || (arena == NULL) || (entries == NULL))
+    return false; ///< Failed
+  help_table_t empty = {0};
+  *t = empty;
+  t->arena = arena;
+  t->arena_size = arena_size;
+  t->entries = entries;
+  t->entries_max = entries_max;
+  t->margin_tab_count = margin_tab_count;
+  t->spaces_per_tab = spaces_per_tab;
+  return true; ///< Successful
+}
+
+/* True if the table needs to be rebuilt for this registry generation */
+static inline bool help_table_is_stale(const help_table_t *t, uint32_t generation)
+{
+  return !t->valid || (t->generation != generation);
+}
+
+/* Start a rebuild. Follow with help_table_add() per command then help_table_end() */
+static inline void help_table_begin(help_table_t *t)
+{
+  t->arena_used = 0;
+  t->entry_count = 0;
+  t->valid = false;
+}
+
+/* Render a command's help string into the arena */
+static inline bool help_table_add(help_table_t *t, const char* command_str_ptr, const char* help_string_ptr)
+{
+  if (t->entry_count >= t->entries_max)
+    return false; ///< Failed: Index full
+
+  const size_t remaining = t->arena_size - t->arena_used;
+  if (remaining < 2)
+    return false; ///< Failed: Arena full
+
+  gen_help_cursor_t cursor;
+  gen_help_cursor_init(&cursor, help_string_ptr);
+  const size_t length = gen_help_str_resumable(&t->arena[t->arena_used], remaining, &cursor, command_str_ptr, t->margin_tab_count, t->spaces_per_tab);
+  if (!gen_help_cursor_done(&cursor))
+    return false; ///< Failed: Arena full
+
+  t->entries[t->entry_count].offset = t->arena_used;
+  t->entries[t->entry_count].length = length;
+  t->entry_count++;
+  t->arena_used += length + 1;
+  return true; ///< Successful
+}
+
+static inline void help_table_end(help_table_t *t, uint32_t generation)
+{
+  t->generation = generation;
+  t->valid = true;
+}
+
+static inline size_t help_table_count(const help_table_t *t)
+{
+  return t->entry_count;
+}
+
+/* Copy a pre-rendered help string into buffer. Returns bytes written (excluding null) */
+static inline size_t help_table_copy(const help_table_t *t, size_t index, char *buffer, size_t buffer_len)
+{
+  if ((buffer_len == 0) || !t->valid || (index >= t->entry_count))
+  {
+    if (buffer_len > 0)
+      buffer[0] = 0;
+    return 0;
+  }
+
+  size_t length = t->entries[index].length;
+  if (length > (buffer_len - 1))
+    length = buffer_len - 1; ///< Truncate like gen_help_str()
+
+  memcpy(buffer, &t->arena[t->entries[index].offset], length);
+  buffer[length] = 0;
+  return length;
+}
+
 #ifdef DEMO
 int main(void)
 {
@@ -177,10 +453,188 @@ int main(void)
 
   printf("%s\n", buff);
 
+  /* Cached help table: render once, then serve each help request by memcpy */
+  static const char *demo_commands[][2] = {
+    {"write", "... <addr> <value>: Write a value to a register\r\n"},
+    {"read",  "... <addr>: Read a register\r\n"},
+    {"reset", "... : Reset the device\r\n"},
+  };
+  static char help_arena[512];
+  static help_table_entry_t help_entries[8];
+  help_table_t help_table;
+  help_table_init(&help_table, help_arena, sizeof(help_arena), help_entries, sizeof(help_entries)/sizeof(help_entries[0]), 4, 8);
+  uint32_t registry_generation = 1;
+
+  if (help_table_is_stale(&help_table, registry_generation))
+  {
+    bool built = true;
+    help_table_begin(&help_table);
+    for (size_t i = 0; built && (i < (sizeof(demo_commands)/sizeof(demo_commands[0]))); i++)
+    {
+      built = help_table_add(&help_table, demo_commands[i][0], demo_commands[i][1]);
+    }
+    if (built)
+      help_table_end(&help_table, registry_generation); ///< Only mark valid once every command fits
+  }
+
+  for (size_t i = 0; i < (sizeof(demo_commands)/sizeof(demo_commands[0])); i++)
+  {
+    char line[80];
+    if (help_table_is_stale(&help_table, registry_generation))
+      gen_help_str(line, sizeof(line), demo_commands[i][0], demo_commands[i][1], 4, 8); ///< Table too small, render directly
+    else
+      help_table_copy(&help_table, i, line, sizeof(line));
+    printf("%s", line);
+  }
+
+  /* Resumable: emit a long help entry through a small write buffer */
+  gen_help_cursor_t cursor;
+  gen_help_cursor_init(&cursor,
+    "... <addr> <value>: Write a value to a register\r\n"
+    "...  -v <addr> <value>: Write then read back to verify\r\n");
+  while (!gen_help_cursor_done(&cursor))
+  {
+    char chunk[8];
+    size_t len = gen_help_str_resumable(chunk, sizeof(chunk), &cursor, "write", 4, 8);
+    fwrite(chunk, 1, len, stdout);
+  }
+
   return 0;
 }
 #endif //DEMO
 
+#ifdef TEST
+/*******************************************************************************
+ * Mini Unit Test Of Help Table
+*******************************************************************************/
+
+// Minimum Assert Unit (https://jera.com/techinfo/jtns/jtn002)
+#define mu_assert(message, test) do { if (!(test)) return LINEINFO " : (expect:" #test ") " message; } while (0)
+#define mu_run_test(test) do { char *message = test(); if (message) return message; } while (0)
+
+// Line Info (Ref: __LINE__ to string http://decompile.com/cpp/faq/file_and_line_error_string.htm)
+#define LINEINFO_STR(X) #X
+#define LINEINFO__STR(X) LINEINFO_STR(X)
+#define LINEINFO __FILE__ " : " LINEINFO__STR(__LINE__)
+
+char * help_table_test_matches_gen_help_str(void)
+{
+  static const char *commands[][2] = {
+    {"write", "... <addr> <value>: Write a value to a register\r\n...  -v <addr> <value>: Write then read back\r\n"},
+    {"read",  "... <addr>: Read a register\r\n"},
+    {"reset", "... : Reset the device\r\n"},
+  };
+  char arena[512];
+  help_table_entry_t entries[8];
+  help_table_t t = help_table_struct_prefill(arena, entries, 4, 8);
+  mu_assert("", help_table_is_stale(&t, 1));
+  help_table_begin(&t);
+  for (size_t i = 0; i < 3; i++)
+    mu_assert("", help_table_add(&t, commands[i][0], commands[i][1]));
+  help_table_end(&t, 1);
+  mu_assert("", !help_table_is_stale(&t, 1) && help_table_is_stale(&t, 2));
+  mu_assert("", help_table_count(&t) == 3);
+  for (size_t i = 0; i < 3; i++)
+  {
+    char expect[128];
+    char got[128];
+    gen_help_str(expect, sizeof(expect), commands[i][0], commands[i][1], 4, 8);
+    mu_assert("", help_table_copy(&t, i, got, sizeof(got)) == strlen(expect));
+    mu_assert("", strcmp(got, expect) == 0);
+  }
+  return 0;
+}
+
+char * help_table_test_index_full(void)
+{
+  char arena[512];
+  help_table_entry_t entries[2];
+  help_table_t t = help_table_struct_prefill(arena, entries, 4, 8);
+  help_table_begin(&t);
+  mu_assert("", help_table_add(&t, "read", "... : Read\r\n"));
+  mu_assert("", help_table_add(&t, "write", "... : Write\r\n"));
+  mu_assert("", !help_table_add(&t, "reset", "... : Reset\r\n"));
+  mu_assert("", help_table_count(&t) == 2);
+  return 0;
+}
+
+char * help_table_test_arena_exactly_full(void)
+{
+  /* Size the arena to exactly one rendered entry (plus its null) */
+  char rendered[64];
+  gen_help_cursor_t cursor;
+  gen_help_cursor_init(&cursor, "... : Reset the device\r\n");
+  const size_t length = gen_help_str_resumable(rendered, sizeof(rendered), &cursor, "reset", 4, 8);
+  mu_assert("", gen_help_cursor_done(&cursor));
+
+  char arena[64];
+  help_table_entry_t entries[8];
+  help_table_t t;
+  mu_assert("", help_table_init(&t, arena, length + 1, entries, 8, 4, 8));
+  help_table_begin(&t);
+  mu_assert("", help_table_add(&t, "reset", "... : Reset the device\r\n"));
+  mu_assert("", t.arena_used == t.arena_size);
+
+  /* Nothing fits now, not even an empty entry, and the arena must not be overrun */
+  mu_assert("", !help_table_add(&t, "empty", ""));
+  mu_assert("", t.arena_used == t.arena_size);
+  mu_assert("", !help_table_add(&t, "empty", ""));
+  mu_assert("", t.arena_used == t.arena_size);
+  mu_assert("", help_table_count(&t) == 1);
+
+  /* An entry that would be truncated is rejected rather than stored short */
+  help_table_begin(&t);
+  mu_assert("", !help_table_add(&t, "write", "... <addr> <value>: Write a value to a register\r\n"));
+  mu_assert("", (t.arena_used == 0) && (help_table_count(&t) == 0));
+  return 0;
+}
+
+char * gen_help_test_resumable_chunks(void)
+{
+  static const char *help = "... <addr> <value>: Write a value to a register. Long line, so it spans many chunks\r\n...  -v <addr> <value>: Write then read back (v1.2 .. and later)\r\n";
+  char expect[256];
+  gen_help_cursor_t cursor;
+  gen_help_cursor_init(&cursor, help);
+  const size_t expect_len = gen_help_str_resumable(expect, sizeof(expect), &cursor, "write", 4, 8);
+  mu_assert("", gen_help_cursor_done(&cursor));
+
+  /* Same output whatever the write buffer size */
+  for (size_t chunk_len = 2; chunk_len < 32; chunk_len++)
+  {
+    char got[256];
+    size_t got_len = 0;
+    gen_help_cursor_init(&cursor, help);
+    while (!gen_help_cursor_done(&cursor))
+    {
+      char chunk[32];
+      const size_t len = gen_help_str_resumable(chunk, chunk_len, &cursor, "write", 4, 8);
+      mu_assert("", (len > 0) && (len < chunk_len) && (chunk[len] == 0));
+      mu_assert("", (got_len + len) < sizeof(got));
+      memcpy(&got[got_len], chunk, len);
+      got_len += len;
+    }
+    mu_assert("", (got_len == expect_len) && (memcmp(got, expect, got_len) == 0));
+  }
+  return 0;
+}
+
+static char * all_tests()
+{
+  mu_run_test(help_table_test_matches_gen_help_str);
+  mu_run_test(help_table_test_index_full);
+  mu_run_test(help_table_test_arena_exactly_full);
+  mu_run_test(gen_help_test_resumable_chunks);
+  return 0;
+}
+
+int main(void)
+{
+  char *result = all_tests();
+  printf("%s\n", (result) ? result : "ALL TESTS PASSED\n");
+  return result != 0;
+}
+#endif //TEST
+
 #if 0 // Use this in /FreeRTOS-Plus-CLI/FreeRTOS_CLI.c
 static BaseType_t prvHelpCommand(
   char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString, uint32_t *has_error )
@@ -214,4 +668,96 @@ BaseType_t xReturn;
 
   return xReturn;
 }
+
+/* Paged variant. Long help strings are split over as many calls as the write buffer requires */
+static BaseType_t prvHelpCommandPaged(
+  char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString, uint32_t *has_error )
+{
+static const CLI_Definition_List_Item_t * pxCommand = NULL;
+static gen_help_cursor_t xCursor;
+
+  ( void ) pcCommandString;
+
+  if( pxCommand == NULL )
+  {
+    /* Reset the pxCommand pointer back to the start of the list. */
+    pxCommand = &xRegisteredCommands;
+    gen_help_cursor_init( &xCursor, pxCommand->pxCommandLineDefinition->pcHelpString );
+  }
+
+  gen_help_str_resumable( pcWriteBuffer, xWriteBufferLen, &xCursor, pxCommand->pxCommandLineDefinition->pcCommand, 4, 8 );
+
+  if( gen_help_cursor_done( &xCursor ) )
+  {
+    /* Move on to the next command in the list */
+    pxCommand = pxCommand->pxNext;
+    if( pxCommand == NULL )
+    {
+      return pdFALSE;
+    }
+    gen_help_cursor_init( &xCursor, pxCommand->pxCommandLineDefinition->pcHelpString );
+  }
+
+  return pdTRUE;
+}
+
+/* Cached variant. Bump `uxHelpTableGeneration` in FreeRTOS_CLIRegisterCommand() so the table is rebuilt on change */
+static char cHelpArena[ 2048 ];
+static help_table_entry_t xHelpEntries[ 64 ];
+static help_table_t xHelpTable = help_table_struct_prefill(cHelpArena, xHelpEntries, 4, 8);
+static uint32_t uxHelpTableGeneration = 0;
+
+static BaseType_t prvHelpCommandCached(
+  char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString, uint32_t *has_error )
+{
+static size_t xIndex = 0;
+static BaseType_t xUncached = pdFALSE;
+static BaseType_t xBuildTried = pdFALSE;
+static uint32_t uxBuildTriedGeneration = 0;
+
+  if( ( xIndex == 0 ) && !xUncached )
+  {
+    /* Rebuild when stale (once per generation). Only mark the table valid if every command fitted */
+    if( help_table_is_stale( &xHelpTable, uxHelpTableGeneration )
+        && ( !xBuildTried || ( uxBuildTriedGeneration != uxHelpTableGeneration ) ) )
+    {
+      BaseType_t xBuilt = pdTRUE;
+      xBuildTried = pdTRUE;
+      uxBuildTriedGeneration = uxHelpTableGeneration;
+      help_table_begin( &xHelpTable );
+      for( const CLI_Definition_List_Item_t *pxItem = &xRegisteredCommands; ( pxItem != NULL ) && xBuilt; pxItem = pxItem->pxNext )
+      {
+        xBuilt = help_table_add( &xHelpTable, pxItem->pxCommandLineDefinition->pcCommand, pxItem->pxCommandLineDefinition->pcHelpString ) ? pdTRUE : pdFALSE;
+      }
+      if( xBuilt )
+      {
+        help_table_end( &xHelpTable, uxHelpTableGeneration );
+      }
+    }
+
+    /* Arena or index too small for the registered commands, list them uncached rather than dropping any */
+    xUncached = help_table_is_stale( &xHelpTable, uxHelpTableGeneration ) ? pdTRUE : pdFALSE;
+  }
+
+  if( xUncached )
+  {
+    xUncached = prvHelpCommand( pcWriteBuffer, xWriteBufferLen, pcCommandString, has_error );
+    return xUncached;
+  }
+
+  ( void ) pcCommandString;
+
+  /* Return the next pre-rendered help string */
+  help_table_copy( &xHelpTable, xIndex, pcWriteBuffer, xWriteBufferLen );
+  xIndex++;
+
+  if( xIndex >= help_table_count( &xHelpTable ) )
+  {
+    /* No more strings to return after this one */
+    xIndex = 0;
+    return pdFALSE;
+  }
+
+  return pdTRUE;
+}
 #endif
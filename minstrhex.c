@@ -1,5 +1,48 @@
+//usr/bin/clang -DDEMO "$0" && exec ./a.out "$@"
+
+/*
+  Minimal string building helpers. Each append_*() writes at `str` and returns
+  the pointer just past what it wrote, so calls can be chained.
+
+  `minstr_t` is the bounds checked form (cursor + end + overflow flag). The
+  `MINSTR_FMT()` macro strings its arguments together into a straight line of
+  minstr_append_*() calls, so a log line is formatted without any format
+  string being parsed at runtime:
+
+  ```
+  MINSTR_FMT(&sb, MINSTR_S("temp="), MINSTR_I32(t), MINSTR_S(" id=0x"), MINSTR_HEX32(id));
+  // Same output as snprintf(buf, len, "temp=%d id=0x%08X", t, id)
+  ```
+
+  `append_hex_block()` converts whole buffers to hex 16 bytes at a time
+  (SSE2 / NEON, with a scalar fallback), and the `hexdump` functions build a
+  `hexdump -C` compatible dump on top of it.
+
+  `append_fixed()` prints Q format fixed point (Q15, Q16.16, ...) and
+  `append_float()` prints the shortest decimal that reads back as the same
+  float (Ryu). Neither needs printf("%f") or libm.
+
+  The `parse_*()` functions are the inverse: hex to bytes (SSE2 / NEON) and
+  decimal (8 digits at a time with SWAR), reporting the exact position of any
+  bad character or of the digit that overflowed.
+
+  Unit Test: clang -DTEST minstrhex.c && ./a.out
+  Benchmark: clang -O2 -DBENCH minstrhex.c && ./a.out
+*/
+
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MINSTR_HEX_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MINSTR_HEX_NEON
+#endif
 
 char *append_str(char *strA, char *strB)
 {
@@ -17,7 +60,1319 @@ char *append_hex(char *str, char tmp)
     return str + 2;
 }
 
+/*******************************************************************************
+ * Integer To Decimal
+ * Two digits at a time from a lookup table, with the digit count predicted
+ * up front so digits are written straight into place (no reversing).
+ * Only divides by constants, which compilers turn into a multiply.
+*******************************************************************************/
+
+static const char minstr_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static inline int minstr_digits_u32(uint32_t val)
+{
+    static const uint32_t powers[10] = {0, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+#if defined(__GNUC__)
+    int bits = 32 - __builtin_clz(val | 1);
+#else
+    int bits = 1;
+    while ((bits < 32) && (val >> bits))
+        bits++;
+#endif
+    int t = (bits * 1233) >> 12; // ~ bits * log10(2)
+    return t + 1 - (val < powers[t]);
+}
+
+/* Write `digits` digits of val ending just before `end` */
+static inline void minstr_write_u32(char *end, uint32_t val)
+{
+    while (val >= 100)
+    {
+        const uint32_t pair = (val % 100) * 2;
+        val /= 100;
+        *--end = minstr_digit_pairs[pair + 1];
+        *--end = minstr_digit_pairs[pair];
+    }
+    if (val >= 10)
+    {
+        *--end = minstr_digit_pairs[val * 2 + 1];
+        *--end = minstr_digit_pairs[val * 2];
+    }
+    else
+    {
+        *--end = (char)('0' + val);
+    }
+}
+
+/* Write exactly 8 digits (with leading zeros) */
+static inline void minstr_write_8digits(char *str, uint32_t val)
+{
+    for (int i = 6; i >= 0; i -= 2)
+    {
+        const uint32_t pair = (val % 100) * 2;
+        val /= 100;
+        str[i] = minstr_digit_pairs[pair];
+        str[i + 1] = minstr_digit_pairs[pair + 1];
+    }
+}
+
+static inline char *minstr_zero_pad(char *str, int digits, uint8_t minDigits)
+{
+    for (int i = digits ; i < minDigits ; i++)
+        *str++ = '0';
+    return str;
+}
+
+char *append_uint32_pad(char *str, uint32_t val, uint8_t minDigits)
+{
+    const int digits = minstr_digits_u32(val);
+    str = minstr_zero_pad(str, digits, minDigits);
+    minstr_write_u32(str + digits, val);
+    return str + digits;
+}
+
+char *append_uint32(char *str, uint32_t val)
+{
+    return append_uint32_pad(str, val, 0);
+}
+
+char *append_int32(char *str, int32_t val)
+{
+    if (val < 0)
+    {
+        *str++ = '-';
+        return append_uint32(str, 0u - (uint32_t)val); // Safe for INT32_MIN
+    }
+    return append_uint32(str, (uint32_t)val);
+}
+
+char *append_uint64_pad(char *str, uint64_t val, uint8_t minDigits)
+{
+    if (val <= UINT32_MAX)
+        return append_uint32_pad(str, (uint32_t)val, minDigits);
+
+    /* Split into 8 digit chunks so the bulk of the work is 32 bit */
+    const uint32_t low = (uint32_t)(val % 100000000u);
+    val /= 100000000u;
+    if (val <= UINT32_MAX)
+    {
+        const uint32_t high = (uint32_t)val;
+        const int digits = minstr_digits_u32(high);
+        str = minstr_zero_pad(str, digits + 8, minDigits);
+        minstr_write_u32(str + digits, high);
+        minstr_write_8digits(str + digits, low);
+        return str + digits + 8;
+    }
+
+    const uint32_t mid = (uint32_t)(val % 100000000u);
+    const uint32_t high = (uint32_t)(val / 100000000u); // At most 4 digits
+    const int digits = minstr_digits_u32(high);
+    str = minstr_zero_pad(str, digits + 16, minDigits);
+    minstr_write_u32(str + digits, high);
+    minstr_write_8digits(str + digits, mid);
+    minstr_write_8digits(str + digits + 8, low);
+    return str + digits + 16;
+}
+
+char *append_uint64(char *str, uint64_t val)
+{
+    return append_uint64_pad(str, val, 0);
+}
+
+char *append_int64(char *str, int64_t val)
+{
+    if (val < 0)
+    {
+        *str++ = '-';
+        return append_uint64(str, 0u - (uint64_t)val); // Safe for INT64_MIN
+    }
+    return append_uint64(str, (uint64_t)val);
+}
+
+/*
+  Original interface, with the same output as the original repeated subtraction version.
+  Digits are written from the 10^padCount place down without leading zeros, and negative
+  values are clamped to 0 (use append_int32() for a sign). A value of 10^(padCount+1) or
+  more still puts a single out of range character in the top place. padCount above 9 acts as 9.
+*/
 char *append_digit(char *str, int val, char padCount)
+{
+    if (val < 0)
+        val = 0;
+    if (padCount < 0)
+        padCount = 0;
+    if (padCount > 9)
+        padCount = 9;
+    uint32_t exponent = 1;
+    for (int i = 0 ; i < padCount ; i++)
+        exponent *= 10;
+
+    const uint32_t top = (uint32_t)val / exponent;
+    if (top == 0)
+        return append_uint32(str, (uint32_t)val);
+    *str++ = (char)('0' + top);
+    if (exponent == 1)
+        return str;
+    return append_uint32_pad(str, (uint32_t)val % exponent, (uint8_t)padCount);
+}
+
+/*******************************************************************************
+ * Fixed Point And Float To Decimal (No libm, no printf)
+*******************************************************************************/
+
+static const uint32_t minstr_pow10_u32[10] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+/*
+  Q format fixed point, printed as `val / 2^fracBits` with `fracDigits` (0 to 9)
+  digits after the point. Q15 is fracBits 15, Q16.16 is fracBits 16.
+  Rounds half to even, same as printf("%.*f") on the exact value.
+*/
+char *append_fixed(char *str, int32_t val, uint8_t fracBits, uint8_t fracDigits)
+{
+    if (fracBits > 31)
+        fracBits = 31;
+    if (fracDigits > 9)
+        fracDigits = 9;
+    if (val < 0)
+        *str++ = '-';
+
+    const uint32_t mag = (val < 0) ? 0u - (uint32_t)val : (uint32_t)val;
+    const uint64_t mask = (1ull << fracBits) - 1;
+    const uint64_t half = (1ull << fracBits) >> 1;
+    const uint32_t scale = minstr_pow10_u32[fracDigits];
+    uint32_t whole = mag >> fracBits;
+    const uint64_t scaled = (uint64_t)(mag & mask) * scale; // < 2^31 * 10^9, fits
+    uint32_t frac = (uint32_t)(scaled >> fracBits);
+    const uint64_t rem = scaled & mask;
+    const uint32_t lsb = fracDigits ? frac : whole;
+    if ((rem > half) || ((half != 0) && (rem == half) && (lsb & 1)))
+        frac++;
+    if (frac >= scale)
+    { /* Rounded up into the whole part */
+        frac -= scale;
+        whole++;
+    }
+
+    str = append_uint32(str, whole);
+    if (fracDigits == 0)
+        return str;
+    *str++ = '.';
+    return append_uint32_pad(str, frac, fracDigits);
+}
+
+/*
+  Shortest float to decimal (Ryu, Ulf Adams 2018 https://github.com/ulfjack/ryu)
+  Finds the fewest digits that still read back as the same float, choosing the
+  closest when there are several. Tables are 5^i and 2^k/5^i scaled to 64 bits:
+    pow5_inv_split[i] = floor(2^(pow5bits(i) - 1 + 59) / 5^i) + 1
+    pow5_split[i]     = 5^i >> (pow5bits(i) - 61)
+*/
+#define MINSTR_F32_MANTISSA_BITS   23
+#define MINSTR_F32_BIAS            127
+#define MINSTR_F32_POW5_INV_BITS   59
+#define MINSTR_F32_POW5_BITS       61
+#define MINSTR_F32_MAX_CHARS       15 ///< "-1.23456789e-38" or "-0.000123456789"
+
+static const uint64_t minstr_f32_pow5_inv_split[31] = {
+    576460752303423489u, 461168601842738791u, 368934881474191033u,
+    295147905179352826u, 472236648286964522u, 377789318629571618u,
+    302231454903657294u, 483570327845851670u, 386856262276681336u,
+    309485009821345069u, 495176015714152110u, 396140812571321688u,
+    316912650057057351u, 507060240091291761u, 405648192073033409u,
+    324518553658426727u, 519229685853482763u, 415383748682786211u,
+    332306998946228969u, 531691198313966350u, 425352958651173080u,
+    340282366920938464u, 544451787073501542u, 435561429658801234u,
+    348449143727040987u, 557518629963265579u, 446014903970612463u,
+    356811923176489971u, 570899077082383953u, 456719261665907162u,
+    365375409332725730u,
+};
+
+static const uint64_t minstr_f32_pow5_split[48] = {
+    1152921504606846976u, 1441151880758558720u, 1801439850948198400u,
+    2251799813685248000u, 1407374883553280000u, 1759218604441600000u,
+    2199023255552000000u, 1374389534720000000u, 1717986918400000000u,
+    2147483648000000000u, 1342177280000000000u, 1677721600000000000u,
+    2097152000000000000u, 1310720000000000000u, 1638400000000000000u,
+    2048000000000000000u, 1280000000000000000u, 1600000000000000000u,
+    2000000000000000000u, 1250000000000000000u, 1562500000000000000u,
+    1953125000000000000u, 1220703125000000000u, 1525878906250000000u,
+    1907348632812500000u, 1192092895507812500u, 1490116119384765625u,
+    1862645149230957031u, 1164153218269348144u, 1455191522836685180u,
+    1818989403545856475u, 2273736754432320594u, 1421085471520200371u,
+    1776356839400250464u, 2220446049250313080u, 1387778780781445675u,
+    1734723475976807094u, 2168404344971008868u, 1355252715606880542u,
+    1694065894508600678u, 2117582368135750847u, 1323488980084844279u,
+    1654361225106055349u, 2067951531382569187u, 1292469707114105741u,
+    1615587133892632177u, 2019483917365790221u, 1262177448353618888u,
+};
+
+static inline int32_t minstr_pow5bits(int32_t e)   { return (int32_t)(((uint32_t)e * 1217359u) >> 19) + 1; } ///< ceil(log2(5^e))
+static inline uint32_t minstr_log10_pow2(int32_t e) { return ((uint32_t)e * 78913u) >> 18; }  ///< floor(log10(2^e))
+static inline uint32_t minstr_log10_pow5(int32_t e) { return ((uint32_t)e * 732923u) >> 20; }  ///< floor(log10(5^e))
+
+static inline bool minstr_multiple_of_pow5(uint32_t val, uint32_t p)
+{
+    uint32_t count = 0;
+    while ((val % 5) == 0)
+    {
+        val /= 5;
+        count++;
+    }
+    return count >= p;
+}
+
+static inline bool minstr_multiple_of_pow2(uint32_t val, uint32_t p)
+{
+    return (val & ((1u << p) - 1)) == 0;
+}
+
+/* (m * factor) >> shift, with shift > 32 */
+static inline uint32_t minstr_mul_shift32(uint32_t m, uint64_t factor, int32_t shift)
+{
+    const uint64_t bits0 = (uint64_t)m * (uint32_t)factor;
+    const uint64_t bits1 = (uint64_t)m * (uint32_t)(factor >> 32);
+    return (uint32_t)(((bits0 >> 32) + bits1) >> (shift - 32));
+}
+
+/* Float bits to shortest `digits * 10^exp10` */
+static void minstr_f32_to_decimal(uint32_t ieeeMantissa, uint32_t ieeeExponent, uint32_t *digits, int32_t *exp10)
+{
+    int32_t e2;
+    uint32_t m2;
+    if (ieeeExponent == 0)
+    { /* Subnormal */
+        e2 = 1 - MINSTR_F32_BIAS - MINSTR_F32_MANTISSA_BITS - 2;
+        m2 = ieeeMantissa;
+    }
+    else
+    {
+        e2 = (int32_t)ieeeExponent - MINSTR_F32_BIAS - MINSTR_F32_MANTISSA_BITS - 2;
+        m2 = (1u << MINSTR_F32_MANTISSA_BITS) | ieeeMantissa;
+    }
+    const bool acceptBounds = (m2 & 1) == 0; ///< Round to even reads the halfway bounds back as us
+
+    /* Interval of values that read back as this float, all scaled by 4 */
+    const uint32_t mv = 4 * m2;
+    const uint32_t mp = 4 * m2 + 2;
+    const uint32_t mmShift = (ieeeMantissa != 0) || (ieeeExponent <= 1);
+    const uint32_t mm = 4 * m2 - 1 - mmShift;
+
+    /* Convert the interval to decimal */
+    uint32_t vr, vp, vm;
+    int32_t e10;
+    bool vmIsTrailingZeros = false;
+    bool vrIsTrailingZeros = false;
+    uint8_t lastRemovedDigit = 0;
+    if (e2 >= 0)
+    {
+        const uint32_t q = minstr_log10_pow2(e2);
+        e10 = (int32_t)q;
+        const int32_t k = MINSTR_F32_POW5_INV_BITS + minstr_pow5bits((int32_t)q) - 1;
+        const int32_t i = -e2 + (int32_t)q + k;
+        vr = minstr_mul_shift32(mv, minstr_f32_pow5_inv_split[q], i);
+        vp = minstr_mul_shift32(mp, minstr_f32_pow5_inv_split[q], i);
+        vm = minstr_mul_shift32(mm, minstr_f32_pow5_inv_split[q], i);
+        if ((q != 0) && (((vp - 1) / 10) <= (vm / 10)))
+        { /* The loop below removes at most one digit, so work out the digit it would drop */
+            const int32_t l = MINSTR_F32_POW5_INV_BITS + minstr_pow5bits((int32_t)q - 1) - 1;
+            lastRemovedDigit = (uint8_t)(minstr_mul_shift32(mv, minstr_f32_pow5_inv_split[q - 1], -e2 + (int32_t)q - 1 + l) % 10);
+        }
+        if (q <= 9)
+        { /* Only one of mp, mv, mm can be a multiple of 5, if any */
+            if ((mv % 5) == 0)
+                vrIsTrailingZeros = minstr_multiple_of_pow5(mv, q);
+            else if (acceptBounds)
+                vmIsTrailingZeros = minstr_multiple_of_pow5(mm, q);
+            else
+                vp -= minstr_multiple_of_pow5(mp, q);
+        }
+    }
+    else
+    {
+        const uint32_t q = minstr_log10_pow5(-e2);
+        e10 = (int32_t)q + e2;
+        const int32_t i = -e2 - (int32_t)q;
+        const int32_t k = minstr_pow5bits(i) - MINSTR_F32_POW5_BITS;
+        int32_t j = (int32_t)q - k;
+        vr = minstr_mul_shift32(mv, minstr_f32_pow5_split[i], j);
+        vp = minstr_mul_shift32(mp, minstr_f32_pow5_split[i], j);
+        vm = minstr_mul_shift32(mm, minstr_f32_pow5_split[i], j);
+        if ((q != 0) && (((vp - 1) / 10) <= (vm / 10)))
+        {
+            j = (int32_t)q - 1 - (minstr_pow5bits(i + 1) - MINSTR_F32_POW5_BITS);
+            lastRemovedDigit = (uint8_t)(minstr_mul_shift32(mv, minstr_f32_pow5_split[i + 1], j) % 10);
+        }
+        if (q <= 1)
+        { /* mv has at least q trailing zero bits */
+            vrIsTrailingZeros = true;
+            if (acceptBounds)
+                vmIsTrailingZeros = (mmShift == 1);
+            else
+                vp--;
+        }
+        else if (q < 31)
+        {
+            vrIsTrailingZeros = minstr_multiple_of_pow2(mv, q - 1);
+        }
+    }
+
+    /* Drop digits while the interval still holds a shorter number */
+    int32_t removed = 0;
+    uint32_t output;
+    if (vmIsTrailingZeros || vrIsTrailingZeros)
+    { /* Rare: exact ties need care */
+        while ((vp / 10) > (vm / 10))
+        {
+            vmIsTrailingZeros &= (vm % 10) == 0;
+            vrIsTrailingZeros &= lastRemovedDigit == 0;
+            lastRemovedDigit = (uint8_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vmIsTrailingZeros)
+        {
+            while ((vm % 10) == 0)
+            {
+                vrIsTrailingZeros &= lastRemovedDigit == 0;
+                lastRemovedDigit = (uint8_t)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vrIsTrailingZeros && (lastRemovedDigit == 5) && ((vr % 2) == 0))
+            lastRemovedDigit = 4; ///< Exactly halfway, round to even
+        output = vr + (((vr == vm) && (!acceptBounds || !vmIsTrailingZeros)) || (lastRemovedDigit >= 5));
+    }
+    else
+    { /* Common case */
+        while ((vp / 10) > (vm / 10))
+        {
+            lastRemovedDigit = (uint8_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + ((vr == vm) || (lastRemovedDigit >= 5));
+    }
+
+    *digits = output;
+    *exp10 = e10 + removed;
+}
+
+/*
+  Shortest decimal that reads back (strtof) as the same float. Plain notation
+  for 1e-4 <= |val| < 1e9 ("0.15", "1200", "3.25"), else scientific like
+  printf ("1e+10", "1.17549435e-38"). Writes at most MINSTR_F32_MAX_CHARS.
+*/
+char *append_float(char *str, float val)
+{
+    uint32_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    const uint32_t ieeeMantissa = bits & ((1u << MINSTR_F32_MANTISSA_BITS) - 1);
+    const uint32_t ieeeExponent = (bits >> MINSTR_F32_MANTISSA_BITS) & 0xFF;
+
+    if ((ieeeExponent == 0xFF) && (ieeeMantissa != 0))
+        return append_str(str, "nan");
+    if (bits >> 31)
+        *str++ = '-';
+    if (ieeeExponent == 0xFF)
+        return append_str(str, "inf");
+    if ((ieeeExponent == 0) && (ieeeMantissa == 0))
+    {
+        *str++ = '0';
+        return str;
+    }
+
+    uint32_t digits;
+    int32_t exp10;
+    minstr_f32_to_decimal(ieeeMantissa, ieeeExponent, &digits, &exp10);
+
+    char tmp[10];
+    const int olength = (int)(append_uint32(tmp, digits) - tmp);
+    const int point = olength + exp10; ///< Digits before the decimal point
+    if ((point > -4) && (point <= 9))
+    { /* Plain notation */
+        if (point <= 0)
+        {
+            *str++ = '0';
+            *str++ = '.';
+            for (int i = point ; i < 0 ; i++)
+                *str++ = '0';
+            memcpy(str, tmp, (size_t)olength);
+            return str + olength;
+        }
+        if (point >= olength)
+        {
+            memcpy(str, tmp, (size_t)olength);
+            str += olength;
+            for (int i = olength ; i < point ; i++)
+                *str++ = '0';
+            return str;
+        }
+        memcpy(str, tmp, (size_t)point);
+        str[point] = '.';
+        memcpy(str + point + 1, tmp + point, (size_t)(olength - point));
+        return str + olength + 1;
+    }
+
+    /* Scientific notation */
+    *str++ = tmp[0];
+    if (olength > 1)
+    {
+        *str++ = '.';
+        memcpy(str, tmp + 1, (size_t)(olength - 1));
+        str += olength - 1;
+    }
+    const int sciExp = point - 1;
+    *str++ = 'e';
+    *str++ = (sciExp < 0) ? '-' : '+';
+    return append_uint32_pad(str, (uint32_t)((sciExp < 0) ? -sciExp : sciExp), 2);
+}
+
+/*******************************************************************************
+ * Bounds Checked String Builder
+*******************************************************************************/
+
+typedef struct minstr_t
+{
+    char *start;    ///< Start of buffer
+    char *cursor;   ///< Next write position
+    char *end;      ///< Last usable position (kept for the null terminator)
+    bool overflow;  ///< Set if anything was truncated
+} minstr_t;
+
+// Prefill String Builder (Allows for skipping `minstr_init()`)
+#define minstr_struct_prefill(Buff)               \
+{                                                 \
+    .start    = &Buff[0],                         \
+    .cursor   = &Buff[0],                         \
+    .end      = &Buff[0] + sizeof(Buff) - 1,      \
+    .overflow = false                             \
+}
+
+static inline bool minstr_init(minstr_t *sb, char *buffer, size_t size)
+{
+    if ((sb == NULL) || (buffer == NULL) || (size == 0))
+        return false; ///< Failed
+    sb->start = buffer;
+    sb->cursor = buffer;
+    sb->end = buffer + size - 1;
+    sb->overflow = false;
+    return true; ///< Successful
+}
+
+static inline void minstr_reset(minstr_t *sb)
+{
+    sb->cursor = sb->start;
+    sb->overflow = false;
+}
+
+static inline size_t minstr_room(const minstr_t *sb)
+{
+    return (size_t)(sb->end - sb->cursor);
+}
+
+static inline size_t minstr_length(const minstr_t *sb)
+{
+    return (size_t)(sb->cursor - sb->start);
+}
+
+/* Null terminate and return the string */
+static inline const char *minstr_finish(minstr_t *sb)
+{
+    *sb->cursor = '\0';
+    return sb->start;
+}
+
+/* Copy as much of `len` bytes as fits, flagging overflow if truncated */
+static inline void minstr_append_mem(minstr_t *sb, const char *src, size_t len)
+{
+    const size_t room = minstr_room(sb);
+    if (len > room)
+    {
+        len = room;
+        sb->overflow = true;
+    }
+    memcpy(sb->cursor, src, len);
+    sb->cursor += len;
+}
+
+static inline void minstr_append_char(minstr_t *sb, char c)
+{
+    if (sb->cursor >= sb->end)
+    {
+        sb->overflow = true;
+        return;
+    }
+    *sb->cursor++ = c;
+}
+
+static inline void minstr_append_str(minstr_t *sb, const char *str)
+{
+    minstr_append_mem(sb, str, strlen(str));
+}
+
+static inline void minstr_append_pad(minstr_t *sb, char c, size_t count)
+{
+    const size_t room = minstr_room(sb);
+    if (count > room)
+    {
+        count = room;
+        sb->overflow = true;
+    }
+    memset(sb->cursor, c, count);
+    sb->cursor += count;
+}
+
+static inline void minstr_append_hex8(minstr_t *sb, uint8_t val)
+{
+    if (minstr_room(sb) < 2)
+    {
+        sb->overflow = true;
+        return; ///< Never write half a byte
+    }
+    sb->cursor = append_hex(sb->cursor, (char)val);
+}
+
+static inline void minstr_append_hex32(minstr_t *sb, uint32_t val)
+{
+    if (minstr_room(sb) < 8)
+    {
+        sb->overflow = true;
+        return; ///< Never write half a word
+    }
+    for (int shift = 24; shift >= 0; shift -= 8)
+        sb->cursor = append_hex(sb->cursor, (char)(val >> shift));
+}
+
+/* Decimal: write in place when there is room for the widest value, else go through a scratch buffer */
+#define MINSTR_APPEND_DECIMAL(sb, maxChars, appendCall)          \
+    do {                                                         \
+        if (minstr_room(sb) >= (maxChars))                       \
+        {                                                        \
+            char *str = (sb)->cursor;                            \
+            (sb)->cursor = appendCall;                           \
+        }                                                        \
+        else                                                     \
+        {                                                        \
+            char scratch[(maxChars)];                            \
+            char *str = scratch;                                 \
+            char *scratch_end = appendCall;                      \
+            minstr_append_mem(sb, scratch, (size_t)(scratch_end - scratch)); \
+        }                                                        \
+    } while (0)
+
+static inline void minstr_append_u32(minstr_t *sb, uint32_t val)
+{
+    MINSTR_APPEND_DECIMAL(sb, 10, append_uint32(str, val));
+}
+
+static inline void minstr_append_i32(minstr_t *sb, int32_t val)
+{
+    MINSTR_APPEND_DECIMAL(sb, 11, append_int32(str, val));
+}
+
+static inline void minstr_append_u64(minstr_t *sb, uint64_t val)
+{
+    MINSTR_APPEND_DECIMAL(sb, 20, append_uint64(str, val));
+}
+
+static inline void minstr_append_i64(minstr_t *sb, int64_t val)
+{
+    MINSTR_APPEND_DECIMAL(sb, 20, append_int64(str, val));
+}
+
+static inline void minstr_append_u32_pad(minstr_t *sb, uint32_t val, uint8_t minDigits)
+{
+    if (minDigits > 10)
+    { /* Pad beyond the widest value first, so the scratch buffer stays small */
+        const int digits = minstr_digits_u32(val);
+        minstr_append_pad(sb, '0', (size_t)(minDigits - digits));
+        minDigits = 0;
+    }
+    MINSTR_APPEND_DECIMAL(sb, 10, append_uint32_pad(str, val, minDigits));
+}
+
+static inline void minstr_append_fixed(minstr_t *sb, int32_t val, uint8_t fracBits, uint8_t fracDigits)
+{
+    MINSTR_APPEND_DECIMAL(sb, 21, append_fixed(str, val, fracBits, fracDigits));
+}
+
+static inline void minstr_append_float(minstr_t *sb, float val)
+{
+    MINSTR_APPEND_DECIMAL(sb, MINSTR_F32_MAX_CHARS, append_float(str, val));
+}
+
+/*******************************************************************************
+ * Printf-Lite (Format is expanded at compile time into a straight line of appends)
+ * Each spec is an expression, joined by the comma operator inside MINSTR_FMT().
+*******************************************************************************/
+
+#define MINSTR_FMT(sb, ...) do { minstr_t *const minstr_fmt_sb = (sb); (void)(__VA_ARGS__); } while (0)
+
+#define MINSTR_S(str)          minstr_append_str(minstr_fmt_sb, (str))          ///< %s
+#define MINSTR_C(c)            minstr_append_char(minstr_fmt_sb, (c))           ///< %c
+#define MINSTR_U32(val)        minstr_append_u32(minstr_fmt_sb, (val))          ///< %u
+#define MINSTR_I32(val)        minstr_append_i32(minstr_fmt_sb, (val))          ///< %d
+#define MINSTR_U64(val)        minstr_append_u64(minstr_fmt_sb, (val))          ///< %llu
+#define MINSTR_I64(val)        minstr_append_i64(minstr_fmt_sb, (val))          ///< %lld
+#define MINSTR_UPAD(val, w)    minstr_append_u32_pad(minstr_fmt_sb, (val), (w)) ///< %0wu
+#define MINSTR_HEX8(val)       minstr_append_hex8(minstr_fmt_sb, (val))         ///< %02X
+#define MINSTR_HEX32(val)      minstr_append_hex32(minstr_fmt_sb, (val))        ///< %08X
+#define MINSTR_PAD(c, count)   minstr_append_pad(minstr_fmt_sb, (c), (count))
+#define MINSTR_FIX(val, q, d)  minstr_append_fixed(minstr_fmt_sb, (val), (q), (d)) ///< Q format, d digits after the point
+#define MINSTR_F32(val)        minstr_append_float(minstr_fmt_sb, (val))        ///< Shortest round trip float
+
+/*******************************************************************************
+ * Bulk Hex And Hexdump
+*******************************************************************************/
+
+/* Hex encode `len` bytes. `alpha` is 'A' for upper case or 'a' for lower case */
+static inline char *minstr_hex_block(char *str, const uint8_t *data, size_t len, char alpha)
+{
+    const uint8_t alpha_adjust = (uint8_t)(alpha - '0' - 10); // Gap between '9' and alpha
+
+#if defined(MINSTR_HEX_SSE2)
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i ascii_zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i adjust = _mm_set1_epi8((char)alpha_adjust);
+    for (; len >= 16; len -= 16, data += 16, str += 32)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i *)data);
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask);
+        __m128i lo = _mm_and_si128(v, nibble_mask);
+        /* nibble + '0', plus the gap to alpha when above 9 */
+        hi = _mm_add_epi8(_mm_add_epi8(hi, ascii_zero), _mm_and_si128(_mm_cmpgt_epi8(hi, nine), adjust));
+        lo = _mm_add_epi8(_mm_add_epi8(lo, ascii_zero), _mm_and_si128(_mm_cmpgt_epi8(lo, nine), adjust));
+        _mm_storeu_si128((__m128i *)str, _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(str + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#elif defined(MINSTR_HEX_NEON)
+    const uint8x16_t nibble_mask = vdupq_n_u8(0x0F);
+    const uint8x16_t ascii_zero = vdupq_n_u8('0');
+    const uint8x16_t nine = vdupq_n_u8(9);
+    const uint8x16_t adjust = vdupq_n_u8(alpha_adjust);
+    for (; len >= 16; len -= 16, data += 16, str += 32)
+    {
+        const uint8x16_t v = vld1q_u8(data);
+        const uint8x16_t hi = vshrq_n_u8(v, 4);
+        const uint8x16_t lo = vandq_u8(v, nibble_mask);
+        uint8x16x2_t out;
+        out.val[0] = vaddq_u8(vaddq_u8(hi, ascii_zero), vandq_u8(vcgtq_u8(hi, nine), adjust));
+        out.val[1] = vaddq_u8(vaddq_u8(lo, ascii_zero), vandq_u8(vcgtq_u8(lo, nine), adjust));
+        vst2q_u8((uint8_t *)str, out); // Interleaving store
+    }
+#endif
+
+    for (; len > 0; len--, data++)
+    {
+        const uint8_t hi = *data >> 4;
+        const uint8_t lo = *data & 0x0F;
+        *str++ = (char)('0' + hi + ((hi > 9) ? alpha_adjust : 0));
+        *str++ = (char)('0' + lo + ((lo > 9) ? alpha_adjust : 0));
+    }
+    return str;
+}
+
+/* Bulk form of append_hex() (upper case, no separators) */
+char *append_hex_block(char *str, const void *data, size_t len)
+{
+    return minstr_hex_block(str, (const uint8_t *)data, len, 'A');
+}
+
+#define HEXDUMP_BYTES_PER_LINE 16
+#define HEXDUMP_LINE_MAX       79 ///< "00000000  xx xx xx xx xx xx xx xx  xx xx xx xx xx xx xx xx  |................|\n"
+
+/* One `hexdump -C` line of up to 16 bytes */
+static char *hexdump_line(char *str, const uint8_t *line, size_t n, uint32_t offset)
+{
+    char hex[HEXDUMP_BYTES_PER_LINE * 2];
+    const uint8_t offset_bytes[4] = {(uint8_t)(offset >> 24), (uint8_t)(offset >> 16), (uint8_t)(offset >> 8), (uint8_t)offset};
+
+    str = minstr_hex_block(str, offset_bytes, 4, 'a');
+    minstr_hex_block(hex, line, n, 'a');
+
+    /* Spread out to "  xx xx xx xx xx xx xx xx  xx xx ..." padding missing bytes with spaces */
+    memset(str, ' ', 2 + (HEXDUMP_BYTES_PER_LINE * 3) + 2);
+    for (size_t i = 0; i < n; i++)
+    {
+        char *dst = str + 2 + (i * 3) + (i >= 8);
+        dst[0] = hex[i * 2];
+        dst[1] = hex[i * 2 + 1];
+    }
+    str += 2 + (HEXDUMP_BYTES_PER_LINE * 3) + 2;
+
+    /* Printable ASCII gutter */
+    *str++ = '|';
+    for (size_t i = 0; i < n; i++)
+        *str++ = ((line[i] >= 0x20) && (line[i] < 0x7F)) ? (char)line[i] : '.';
+    *str++ = '|';
+    *str++ = '\n';
+    return str;
+}
+
+/* Emit the next line of the dump (or '*' for repeated lines, like hexdump). Returns NULL when finished */
+static char *hexdump_next(char *str, const uint8_t *data, size_t len, size_t *pos, bool *squeezing, uint32_t base_offset)
+{
+    while (*pos < len)
+    {
+        const size_t n = ((len - *pos) < HEXDUMP_BYTES_PER_LINE) ? (len - *pos) : HEXDUMP_BYTES_PER_LINE;
+        const uint8_t *line = &data[*pos];
+        const bool repeat = (*pos >= HEXDUMP_BYTES_PER_LINE) && (n == HEXDUMP_BYTES_PER_LINE)
+                            && (memcmp(line, line - HEXDUMP_BYTES_PER_LINE, HEXDUMP_BYTES_PER_LINE) == 0);
+        *pos += n;
+        if (repeat)
+        {
+            if (*squeezing)
+                continue;
+            *squeezing = true;
+            *str++ = '*';
+            *str++ = '\n';
+            return str;
+        }
+        *squeezing = false;
+        return hexdump_line(str, line, n, (uint32_t)(base_offset + (*pos - n)));
+    }
+
+    if ((*pos == len) && (len > 0))
+    { /* Closing offset line (hexdump prints nothing at all for empty input) */
+        const uint8_t offset_bytes[4] = {(uint8_t)((base_offset + len) >> 24), (uint8_t)((base_offset + len) >> 16), (uint8_t)((base_offset + len) >> 8), (uint8_t)(base_offset + len)};
+        str = minstr_hex_block(str, offset_bytes, 4, 'a');
+        *str++ = '\n';
+        *pos = len + 1;
+        return str;
+    }
+    return NULL;
+}
+
+/* Hexdump into a bounds checked builder. Stops (with overflow set) at the last line that fits. Returns bytes dumped */
+size_t minstr_append_hexdump(minstr_t *sb, const void *data, size_t len, uint32_t base_offset)
+{
+    size_t pos = 0;
+    bool squeezing = false;
+    if (len == 0)
+        return 0; ///< Nothing to dump, not even the closing offset line
+    while (pos <= len)
+    {
+        if (minstr_room(sb) < HEXDUMP_LINE_MAX)
+        {
+            sb->overflow = true;
+            return pos;
+        }
+        char *next = hexdump_next(sb->cursor, (const uint8_t *)data, len, &pos, &squeezing, base_offset);
+        if (next == NULL)
+            break;
+        sb->cursor = next;
+    }
+    return len;
+}
+
+/* Hexdump to a block sink (e.g. uart dma write), in blocks of up to 16 lines */
+void hexdump_to_sink(void (*write_fcptr)(const char *block, size_t len), const void *data, size_t len, uint32_t base_offset)
+{
+    char block[16 * HEXDUMP_LINE_MAX];
+    char *str = block;
+    size_t pos = 0;
+    bool squeezing = false;
+    for (;;)
+    {
+        char *next = hexdump_next(str, (const uint8_t *)data, len, &pos, &squeezing, base_offset);
+        if (next == NULL)
+            break;
+        str = next;
+        if ((size_t)(&block[sizeof(block)] - str) < HEXDUMP_LINE_MAX)
+        {
+            write_fcptr(block, (size_t)(str - block));
+            str = block;
+        }
+    }
+    if (str != block)
+        write_fcptr(block, (size_t)(str - block));
+}
+
+/*******************************************************************************
+ * Parsers (Inverse Of The Above)
+ * All take an explicit length (e.g. from FreeRTOS_CLIGetParameter()) and on
+ * failure set `*errorPos` to the offset of the offending character.
+*******************************************************************************/
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define MINSTR_PARSE_SWAR
+#endif
+
+static inline int minstr_hex_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+static inline bool minstr_parse_fail(size_t *errorPos, size_t pos)
+{
+    if (errorPos)
+        *errorPos = pos;
+    return false;
+}
+
+/* Decode `len` hex characters (upper or lower case) into len/2 bytes */
+bool parse_hex_block(const char *str, size_t len, uint8_t *out, size_t *errorPos)
+{
+    size_t i = 0;
+
+#if defined(MINSTR_HEX_SSE2)
+    const __m128i ascii_zero = _mm_set1_epi8('0');
+    const __m128i ascii_a = _mm_set1_epi8('a');
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    const __m128i bias = _mm_set1_epi8((char)0x80);
+    const __m128i ten = _mm_set1_epi8(10);
+    const __m128i low_byte = _mm_set1_epi16(0x00FF);
+    __m128i nibbles[2];
+    for (; (i + 32) <= len; i += 32, out += 16)
+    {
+        uint32_t valid = 0;
+        for (int h = 0; h < 2; h++)
+        {
+            const __m128i c = _mm_loadu_si128((const __m128i *)&str[i + (size_t)h * 16]);
+            /* Unsigned range checks via signed compare of (x - lo) ^ 0x80 */
+            const __m128i digit_val = _mm_sub_epi8(c, ascii_zero);
+            const __m128i alpha_val = _mm_sub_epi8(_mm_or_si128(c, case_bit), ascii_a);
+            const __m128i is_digit = _mm_cmplt_epi8(_mm_xor_si128(digit_val, bias), _mm_set1_epi8((char)(10 ^ 0x80)));
+            const __m128i is_alpha = _mm_cmplt_epi8(_mm_xor_si128(alpha_val, bias), _mm_set1_epi8((char)(6 ^ 0x80)));
+            valid |= (uint32_t)_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) << (h * 16);
+            nibbles[h] = _mm_or_si128(_mm_and_si128(is_digit, digit_val), _mm_and_si128(is_alpha, _mm_add_epi8(alpha_val, ten)));
+        }
+        if (valid != 0xFFFFFFFFu)
+            break; ///< Let the scalar loop find the exact position
+        /* Each 16 bit lane holds (hi nibble, lo nibble). Combine then pack down to bytes */
+        const __m128i b0 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles[0], low_byte), 4), _mm_srli_epi16(nibbles[0], 8));
+        const __m128i b1 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles[1], low_byte), 4), _mm_srli_epi16(nibbles[1], 8));
+        _mm_storeu_si128((__m128i *)out, _mm_packus_epi16(b0, b1));
+    }
+#elif defined(MINSTR_HEX_NEON)
+    const uint8x16_t ascii_zero = vdupq_n_u8('0');
+    const uint8x16_t ascii_a = vdupq_n_u8('a');
+    const uint8x16_t case_bit = vdupq_n_u8(0x20);
+    for (; (i + 32) <= len; i += 32, out += 16)
+    {
+        const uint8x16x2_t c = vld2q_u8((const uint8_t *)&str[i]); // De-interleave hi/lo characters
+        uint8x16_t nibble[2];
+        uint8x16_t valid = vdupq_n_u8(0xFF);
+        for (int h = 0; h < 2; h++)
+        {
+            const uint8x16_t digit_val = vsubq_u8(c.val[h], ascii_zero);
+            const uint8x16_t alpha_val = vsubq_u8(vorrq_u8(c.val[h], case_bit), ascii_a);
+            const uint8x16_t is_digit = vcleq_u8(digit_val, vdupq_n_u8(9));
+            const uint8x16_t is_alpha = vcleq_u8(alpha_val, vdupq_n_u8(5));
+            valid = vandq_u8(valid, vorrq_u8(is_digit, is_alpha));
+            nibble[h] = vbslq_u8(is_digit, digit_val, vaddq_u8(alpha_val, vdupq_n_u8(10)));
+        }
+        const uint64x2_t valid64 = vreinterpretq_u64_u8(valid);
+        if ((vgetq_lane_u64(valid64, 0) & vgetq_lane_u64(valid64, 1)) != UINT64_MAX)
+            break; ///< Let the scalar loop find the exact position
+        vst1q_u8(out, vorrq_u8(vshlq_n_u8(nibble[0], 4), nibble[1]));
+    }
+#endif
+
+    for (; (i + 2) <= len; i += 2)
+    {
+        const int hi = minstr_hex_value(str[i]);
+        if (hi < 0)
+            return minstr_parse_fail(errorPos, i);
+        const int lo = minstr_hex_value(str[i + 1]);
+        if (lo < 0)
+            return minstr_parse_fail(errorPos, i + 1);
+        *out++ = (uint8_t)((hi << 4) | lo);
+    }
+
+    if (i != len)
+        return minstr_parse_fail(errorPos, i); ///< Failed: Odd length
+    return true;
+}
+
+#if defined(MINSTR_PARSE_SWAR)
+/* True if all 8 bytes are '0' to '9' */
+static inline bool minstr_swar_is_8digits(uint64_t v)
+{
+    return (((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull);
+}
+
+/* Convert 8 ascii digits (first digit in lowest byte) to their value */
+static inline uint32_t minstr_swar_8digits(uint64_t v)
+{
+    v -= 0x3030303030303030ull;
+    v = (v * 10) + (v >> 8);                                          // Pairs
+    v = (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32)))   // Quads then whole
+      + (((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+    return (uint32_t)v;
+}
+#endif
+
+/* Digits only, no sign. `safeDigits` is how many digits can never overflow `max` */
+static bool minstr_parse_digits(const char *str, size_t len, uint64_t max, size_t safeDigits, uint64_t *val, size_t *errorPos)
+{
+    uint64_t acc = 0;
+    size_t i = 0;
+
+    if (len == 0)
+        return minstr_parse_fail(errorPos, 0); ///< Failed: No digits
+
+#if defined(MINSTR_PARSE_SWAR)
+    for (; ((i + 8) <= len) && ((i + 8) <= safeDigits); i += 8)
+    {
+        uint64_t chunk;
+        memcpy(&chunk, &str[i], sizeof(chunk));
+        if (!minstr_swar_is_8digits(chunk))
+            break; ///< Let the scalar loop find the exact position
+        acc = (acc * 100000000u) + minstr_swar_8digits(chunk);
+    }
+#else
+    (void)safeDigits;
+#endif
+
+    for (; i < len; i++)
+    {
+        const unsigned digit = (unsigned)(str[i] - '0');
+        if (digit > 9)
+            return minstr_parse_fail(errorPos, i); ///< Failed: Not a digit
+        if (acc > ((max - digit) / 10))
+            return minstr_parse_fail(errorPos, i); ///< Failed: Overflow at this digit
+        acc = (acc * 10) + digit;
+    }
+
+    *val = acc;
+    return true;
+}
+
+bool parse_uint64(const char *str, size_t len, uint64_t *val, size_t *errorPos)
+{
+    return minstr_parse_digits(str, len, UINT64_MAX, 19, val, errorPos);
+}
+
+bool parse_uint32(const char *str, size_t len, uint32_t *val, size_t *errorPos)
+{
+    uint64_t v = 0;
+    if (!minstr_parse_digits(str, len, UINT32_MAX, 9, &v, errorPos))
+        return false;
+    *val = (uint32_t)v;
+    return true;
+}
+
+bool parse_int64(const char *str, size_t len, int64_t *val, size_t *errorPos)
+{
+    const bool negative = (len > 0) && (str[0] == '-');
+    const size_t skip = ((len > 0) && ((str[0] == '-') || (str[0] == '+'))) ? 1 : 0;
+    uint64_t v = 0;
+    if (!minstr_parse_digits(str + skip, len - skip, negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX, 18, &v, errorPos))
+    {
+        if (errorPos)
+            *errorPos += skip;
+        return false;
+    }
+    *val = negative ? (int64_t)(0u - v) : (int64_t)v;
+    return true;
+}
+
+bool parse_int32(const char *str, size_t len, int32_t *val, size_t *errorPos)
+{
+    const bool negative = (len > 0) && (str[0] == '-');
+    const size_t skip = ((len > 0) && ((str[0] == '-') || (str[0] == '+'))) ? 1 : 0;
+    uint64_t v = 0;
+    if (!minstr_parse_digits(str + skip, len - skip, negative ? (uint64_t)INT32_MAX + 1 : (uint64_t)INT32_MAX, 9, &v, errorPos))
+    {
+        if (errorPos)
+            *errorPos += skip;
+        return false;
+    }
+    *val = negative ? (int32_t)(0u - (uint32_t)v) : (int32_t)v;
+    return true;
+}
+
+#ifdef DEMO
+static void demo_stdout_write(const char *block, size_t len)
+{
+    fwrite(block, 1, len, stdout);
+}
+
+int main(void)
+{
+    char str[1000]={0};
+    char *strPtr = str;
+    strPtr = append_hex(strPtr, '4');
+    strPtr = append_str(strPtr, " hello");
+    strPtr = append_str(strPtr, " world ");
+    strPtr = append_digit(strPtr, 3456, 7);
+    strPtr = append_str(strPtr, "B ");
+    strPtr = append_int32(strPtr, INT32_MIN);
+    strPtr = append_str(strPtr, " ");
+    strPtr = append_uint64(strPtr, UINT64_MAX);
+    strPtr = append_str(strPtr, " ");
+    strPtr = append_uint32_pad(strPtr, 42, 6);
+    printf("%s\n", str);
+
+    /* Bounds checked builder with a compile time expanded format */
+    char line[40];
+    minstr_t sb = minstr_struct_prefill(line);
+    MINSTR_FMT(&sb, MINSTR_S("temp="), MINSTR_I32(-12), MINSTR_S(" id=0x"), MINSTR_HEX32(0xC0FFEE), MINSTR_C(' '), MINSTR_UPAD(7, 3));
+    printf("%s (overflow:%d)\n", minstr_finish(&sb), sb.overflow);
+
+    /* Overflow is flagged rather than running off the end of the buffer */
+    char tiny[12];
+    minstr_t sb_tiny = minstr_struct_prefill(tiny);
+    MINSTR_FMT(&sb_tiny, MINSTR_S("count="), MINSTR_U64(UINT64_MAX));
+    printf("%s (overflow:%d)\n", minstr_finish(&sb_tiny), sb_tiny.overflow);
+
+    /* Sensor telemetry: Q16.16, Q15 and float without printf("%f") */
+    minstr_reset(&sb);
+    MINSTR_FMT(&sb, MINSTR_S("t="), MINSTR_FIX(-1638400 - 19661, 16, 2), MINSTR_S(" g="), MINSTR_FIX(23170, 15, 4), MINSTR_S(" v="), MINSTR_F32(3.3f));
+    printf("%s (overflow:%d)\n", minstr_finish(&sb), sb.overflow);
+
+    /* Bulk hex and hexdump -C style dump */
+    uint8_t packet[90] = "Hello World\n";
+    for (size_t i = 64; i < sizeof(packet); i++)
+        packet[i] = (uint8_t)(i * 7);
+    char hex[2 * 8 + 1] = {0};
+    append_hex_block(hex, packet, 8);
+    printf("%s\n", hex);
+    hexdump_to_sink(demo_stdout_write, packet, sizeof(packet), 0);
+}
+#endif //DEMO
+
+#ifdef TEST
+/*******************************************************************************
+ * Mini Unit Test Of Parsers (Round Trip Against The Formatters)
+*******************************************************************************/
+#include <stdlib.h>
+
+// Minimum Assert Unit (https://jera.com/techinfo/jtns/jtn002)
+#define mu_assert(message, test) do { if (!(test)) return LINEINFO " : (expect:" #test ") " message; } while (0)
+#define mu_run_test(test) do { char *message = test(); if (message) return message; } while (0)
+
+// Line Info (Ref: __LINE__ to string http://decompile.com/cpp/faq/file_and_line_error_string.htm)
+#define LINEINFO_STR(X) #X
+#define LINEINFO__STR(X) LINEINFO_STR(X)
+#define LINEINFO __FILE__ " : " LINEINFO__STR(__LINE__)
+
+static uint64_t test_rand(void)
+{
+    static uint64_t x = 88172645463325252ull;
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    return x;
+}
+
+char * minstr_test_hex_roundtrip(void)
+{
+    uint8_t data[100];
+    uint8_t back[100];
+    char hex[200];
+    for (int round = 0; round < 1000; round++)
+    {
+        const size_t len = (size_t)(test_rand() % sizeof(data));
+        size_t errorPos = 0;
+        for (size_t i = 0; i < len; i++)
+            data[i] = (uint8_t)test_rand();
+        /* Alternate between the single byte and bulk formatters */
+        char *end = hex;
+        if (round & 1)
+            end = append_hex_block(hex, data, len);
+        else
+            for (size_t i = 0; i < len; i++)
+                end = append_hex(end, (char)data[i]);
+        mu_assert("", parse_hex_block(hex, (size_t)(end - hex), back, &errorPos));
+        mu_assert("", memcmp(data, back, len) == 0);
+    }
+    return 0;
+}
+
+char * minstr_test_hex_errors(void)
+{
+    uint8_t back[32];
+    char hex[64];
+    size_t errorPos = 0;
+    mu_assert("", parse_hex_block("0aFf", 4, back, &errorPos) && (back[0] == 0x0A) && (back[1] == 0xFF));
+    mu_assert("", !parse_hex_block("0a0", 3, back, &errorPos) && (errorPos == 2)); // Odd length
+    /* Bad character at every position of a SIMD sized block */
+    for (size_t bad = 0; bad < sizeof(hex); bad++)
+    {
+        memset(hex, 'a', sizeof(hex));
+        hex[bad] = (bad & 1) ? 'g' : ':';
+        mu_assert("", !parse_hex_block(hex, sizeof(hex), back, &errorPos) && (errorPos == bad));
+    }
+    return 0;
+}
+
+char * minstr_test_decimal_roundtrip(void)
+{
+    char str[32];
+    size_t errorPos = 0;
+    for (int round = 0; round < 100000; round++)
+    {
+        const uint64_t r = test_rand();
+        const uint64_t u64 = r >> (r % 64);
+        uint64_t u64_back = 0;
+        uint32_t u32_back = 0;
+        int64_t i64_back = 0;
+        int32_t i32_back = 0;
+        char *end = append_uint64(str, u64);
+        mu_assert("", parse_uint64(str, (size_t)(end - str), &u64_back, &errorPos) && (u64_back == u64));
+        end = append_int64(str, (int64_t)u64);
+        mu_assert("", parse_int64(str, (size_t)(end - str), &i64_back, &errorPos) && (i64_back == (int64_t)u64));
+        end = append_uint32(str, (uint32_t)u64);
+        mu_assert("", parse_uint32(str, (size_t)(end - str), &u32_back, &errorPos) && (u32_back == (uint32_t)u64));
+        end = append_int32(str, (int32_t)u64);
+        mu_assert("", parse_int32(str, (size_t)(end - str), &i32_back, &errorPos) && (i32_back == (int32_t)u64));
+        end = append_digit(str, (int)(int32_t)u64, 9);
+        mu_assert("", parse_int32(str, (size_t)(end - str), &i32_back, &errorPos) && (i32_back == (((int32_t)u64 < 0) ? 0 : (int32_t)u64)));
+    }
+    return 0;
+}
+
+char * minstr_test_decimal_errors(void)
+{
+    uint64_t u64 = 0;
+    uint32_t u32 = 0;
+    int32_t i32 = 0;
+    int64_t i64 = 0;
+    size_t errorPos = 99;
+    mu_assert("", !parse_uint32("", 0, &u32, &errorPos) && (errorPos == 0));
+    mu_assert("", !parse_uint32("12a4", 4, &u32, &errorPos) && (errorPos == 2));
+    mu_assert("", !parse_uint32("1234567x90", 10, &u32, &errorPos) && (errorPos == 7));
+    mu_assert("", parse_uint32("4294967295", 10, &u32, &errorPos) && (u32 == UINT32_MAX));
+    mu_assert("", !parse_uint32("4294967296", 10, &u32, &errorPos) && (errorPos == 9));
+    mu_assert("", parse_uint32("00000000000000004294967295", 26, &u32, &errorPos) && (u32 == UINT32_MAX));
+    mu_assert("", parse_uint64("18446744073709551615", 20, &u64, &errorPos) && (u64 == UINT64_MAX));
+    mu_assert("", !parse_uint64("18446744073709551616", 20, &u64, &errorPos) && (errorPos == 19));
+    mu_assert("", !parse_uint64("123456789012345678901", 21, &u64, &errorPos) && (errorPos == 20));
+    mu_assert("", parse_int32("-2147483648", 11, &i32, &errorPos) && (i32 == INT32_MIN));
+    mu_assert("", !parse_int32("2147483648", 10, &i32, &errorPos) && (errorPos == 9));
+    mu_assert("", !parse_int32("-", 1, &i32, &errorPos) && (errorPos == 1));
+    mu_assert("", parse_int32("+17", 3, &i32, &errorPos) && (i32 == 17));
+    mu_assert("", parse_int64("-9223372036854775808", 20, &i64, &errorPos) && (i64 == INT64_MIN));
+    mu_assert("", !parse_int64("-9223372036854775809", 20, &i64, &errorPos) && (errorPos == 19));
+    return 0;
+}
+
+char * minstr_test_append_digit(void)
+{
+    /* Same output as the original repeated subtraction version */
+    char a[32] = {0};
+    mu_assert("", strcmp((*append_digit(a, 3456, 7) = 0, a), "3456") == 0);
+    mu_assert("", strcmp((*append_digit(a, 0, 3) = 0, a), "0") == 0);
+    mu_assert("", strcmp((*append_digit(a, 7, 0) = 0, a), "7") == 0);
+    mu_assert("", strcmp((*append_digit(a, 1005, 3) = 0, a), "1005") == 0);
+    mu_assert("", strcmp((*append_digit(a, -42, 9) = 0, a), "0") == 0); // Negative clamps to 0
+    mu_assert("", strcmp((*append_digit(a, INT32_MAX, 9) = 0, a), "2147483647") == 0);
+    return 0;
+}
+
+char * minstr_test_hexdump(void)
+{
+    /* Expected output as printed by `hexdump -C` */
+    static const char expect[] =
+        "00000000  00 00 00 00 00 00 00 00  00 00 00 00 00 00 00 00  |................|\n"
+        "*\n"
+        "00000020  41                                                |A|\n"
+        "00000021\n";
+    uint8_t data[33] = {0};
+    data[32] = 'A';
+    char buff[512];
+    minstr_t sb = minstr_struct_prefill(buff);
+    mu_assert("", minstr_append_hexdump(&sb, data, sizeof(data), 0) == sizeof(data));
+    mu_assert("", !sb.overflow && ((size_t)(sb.cursor - buff) == strlen(expect)) && (memcmp(buff, expect, strlen(expect)) == 0));
+
+    /* Empty input prints nothing, not even the closing offset line */
+    char small[8];
+    minstr_t empty = minstr_struct_prefill(small);
+    mu_assert("", minstr_append_hexdump(&empty, data, 0, 0) == 0);
+    mu_assert("", !empty.overflow && (empty.cursor == small));
+    return 0;
+}
+
+char * minstr_test_fixed(void)
+{
+    char a[32] = {0};
+    mu_assert("", strcmp((*append_fixed(a, 49152, 16, 2) = 0, a), "0.75") == 0);    // Q16.16
+    mu_assert("", strcmp((*append_fixed(a, -16384, 15, 3) = 0, a), "-0.500") == 0); // Q15
+    mu_assert("", strcmp((*append_fixed(a, 1, 1, 0) = 0, a), "0") == 0);            // 0.5 ties to even
+    mu_assert("", strcmp((*append_fixed(a, 3, 1, 0) = 0, a), "2") == 0);            // 1.5 ties to even
+    mu_assert("", strcmp((*append_fixed(a, 65535, 16, 2) = 0, a), "1.00") == 0);    // Rounds into the whole part
+    mu_assert("", strcmp((*append_fixed(a, INT32_MIN, 16, 4) = 0, a), "-32768.0000") == 0);
+    return 0;
+}
+
+char * minstr_test_float_roundtrip(void)
+{
+    char a[32] = {0};
+    mu_assert("", strcmp((*append_float(a, 0.1f) = 0, a), "0.1") == 0);
+    mu_assert("", strcmp((*append_float(a, -1200.0f) = 0, a), "-1200") == 0);
+    mu_assert("", strcmp((*append_float(a, 1e-5f) = 0, a), "1e-05") == 0);
+    mu_assert("", strcmp((*append_float(a, 3.4028235e38f) = 0, a), "3.4028235e+38") == 0);
+    mu_assert("", strcmp((*append_float(a, 1.4e-45f) = 0, a), "1e-45") == 0);
+    for (int round = 0; round < 100000; round++)
+    {
+        const uint32_t bits = (uint32_t)test_rand();
+        float val, back;
+        memcpy(&val, &bits, sizeof(val));
+        if (val != val)
+            continue; // NaN
+        char *end = append_float(a, val);
+        *end = 0;
+        mu_assert("", (end - a) <= MINSTR_F32_MAX_CHARS);
+        back = strtof(a, NULL);
+        mu_assert("", memcmp(&val, &back, sizeof(val)) == 0);
+    }
+    return 0;
+}
+
+static char * all_tests()
+{
+    mu_run_test(minstr_test_hex_roundtrip);
+    mu_run_test(minstr_test_hex_errors);
+    mu_run_test(minstr_test_decimal_roundtrip);
+    mu_run_test(minstr_test_decimal_errors);
+    mu_run_test(minstr_test_append_digit);
+    mu_run_test(minstr_test_hexdump);
+    mu_run_test(minstr_test_fixed);
+    mu_run_test(minstr_test_float_roundtrip);
+    return 0;
+}
+
+int main(void)
+{
+    char *result = all_tests();
+    printf("%s\n", (result) ? result : "ALL TESTS PASSED\n");
+    return result != 0;
+}
+#endif //TEST
+
+#ifdef BENCH
+/*******************************************************************************
+ * Benchmark: append_uint32 vs original repeated subtraction vs snprintf
+*******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Original append_digit() implementation, kept for comparison */
+static char *append_digit_subtract(char *str, int val, char padCount)
 {
     int i = 0;
     int unsigned exponent = 1;
@@ -30,7 +1385,7 @@ char *append_digit(char *str, int val, char padCount)
     while (exponent != 0)
     {
 	    int digit = 0;
-        while (val >= exponent)
+        while (val >= (int)exponent)
         {
             digit++;
             val -= exponent;
@@ -47,14 +1402,190 @@ char *append_digit(char *str, int val, char padCount)
     return str + charCount;
 }
 
+static double bench_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#define BENCH_VALUES 4096
+
 int main(void)
 {
-    char str[1000]={0};
-    char *strPtr = str;
-    strPtr = append_hex(strPtr, '4');
-    strPtr = append_str(strPtr, " hello");
-    strPtr = append_str(strPtr, " world ");
-    strPtr = append_digit(strPtr, 3456, 7);
-    strPtr = append_str(strPtr, "B");
-    printf(str);
-}
\ No newline at end of file
+    static int32_t values[BENCH_VALUES];
+    static char out[BENCH_VALUES * MINSTR_F32_MAX_CHARS];
+    const int iterations = 500;
+    uint32_t x = 2463534242u;
+
+    /* Mixed magnitudes, like telemetry counters */
+    for (int i = 0; i < BENCH_VALUES; i++)
+    {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        values[i] = (int32_t)((x & 0x7FFFFFFF) >> (x % 31));
+    }
+
+    /* Check equivalence first */
+    for (int i = 0; i < BENCH_VALUES; i++)
+    {
+        char a[16] = {0}, b[16] = {0};
+        append_digit_subtract(a, values[i], 9);
+        append_uint32(b, (uint32_t)values[i]);
+        if (strcmp(a, b) != 0)
+        {
+            printf("MISMATCH %s != %s\n", a, b);
+            return 1;
+        }
+    }
+
+    size_t chars = 0;
+    double t0 = bench_seconds();
+    for (int it = 0; it < iterations; it++)
+    {
+        char *p = out;
+        for (int i = 0; i < BENCH_VALUES; i++)
+            p = append_digit_subtract(p, values[i], 9);
+        chars = (size_t)(p - out);
+    }
+    double t1 = bench_seconds();
+    for (int it = 0; it < iterations; it++)
+    {
+        char *p = out;
+        for (int i = 0; i < BENCH_VALUES; i++)
+            p = append_uint32(p, (uint32_t)values[i]);
+    }
+    double t2 = bench_seconds();
+    for (int it = 0; it < iterations; it++)
+    {
+        char *p = out;
+        for (int i = 0; i < BENCH_VALUES; i++)
+            p += snprintf(p, 12, "%d", values[i]);
+    }
+    double t3 = bench_seconds();
+
+    /* Whole log line: MINSTR_FMT vs snprintf */
+    char line[64];
+    size_t line_chars = 0;
+    for (int it = 0; it < iterations; it++)
+    {
+        for (int i = 0; i < BENCH_VALUES; i++)
+        {
+            minstr_t sb = minstr_struct_prefill(line);
+            MINSTR_FMT(&sb, MINSTR_S("t="), MINSTR_I32(values[i]), MINSTR_S(" id=0x"), MINSTR_HEX32((uint32_t)i), MINSTR_S(" n="), MINSTR_UPAD((uint32_t)it, 5));
+            line_chars += minstr_length(&sb);
+        }
+    }
+    double t4 = bench_seconds();
+    for (int it = 0; it < iterations; it++)
+    {
+        for (int i = 0; i < BENCH_VALUES; i++)
+            line_chars += (size_t)snprintf(line, sizeof(line), "t=%d id=0x%08X n=%05u", values[i], (unsigned)i, (unsigned)it);
+    }
+    double t5 = bench_seconds();
+
+    /* Bulk hex: append_hex_block vs append_hex loop */
+    static char hex_out[sizeof(values) * 2];
+    const uint8_t *raw = (const uint8_t *)values;
+    for (int it = 0; it < iterations; it++)
+    {
+        char *p = hex_out;
+        for (size_t i = 0; i < sizeof(values); i++)
+            p = append_hex(p, (char)raw[i]);
+    }
+    double t6 = bench_seconds();
+    for (int it = 0; it < iterations; it++)
+        append_hex_block(hex_out, raw, sizeof(values));
+    double t7 = bench_seconds();
+
+    /* Parsing: parse_hex_block and parse_uint32 vs sscanf / strtoul */
+    static uint8_t hex_back[sizeof(values)];
+    size_t errorPos = 0;
+    for (int it = 0; it < iterations; it++)
+        parse_hex_block(hex_out, sizeof(hex_out), hex_back, &errorPos);
+    double t8 = bench_seconds();
+    for (int it = 0; it < iterations / 10; it++)
+    {
+        for (size_t i = 0; i < sizeof(values); i++)
+        {
+            unsigned byte = 0;
+            sscanf(&hex_out[i * 2], "%2x", &byte);
+            hex_back[i] = (uint8_t)byte;
+        }
+    }
+    double t9 = bench_seconds();
+    static char dec_str[BENCH_VALUES][12];
+    static uint8_t dec_len[BENCH_VALUES];
+    for (int i = 0; i < BENCH_VALUES; i++)
+        dec_len[i] = (uint8_t)(append_uint32(dec_str[i], (uint32_t)values[i]) - dec_str[i]);
+    uint64_t checksum = 0;
+    for (int it = 0; it < iterations; it++)
+    {
+        for (int i = 0; i < BENCH_VALUES; i++)
+        {
+            uint32_t v = 0;
+            parse_uint32(dec_str[i], dec_len[i], &v, &errorPos);
+            checksum += v;
+        }
+    }
+    double t10 = bench_seconds();
+    for (int it = 0; it < iterations; it++)
+    {
+        for (int i = 0; i < BENCH_VALUES; i++)
+            checksum += strtoul(dec_str[i], NULL, 10);
+    }
+    double t11 = bench_seconds();
+
+    /* Fixed point and float vs snprintf */
+    static float fvalues[BENCH_VALUES];
+    for (int i = 0; i < BENCH_VALUES; i++)
+        fvalues[i] = (float)values[i] / 65536.0f;
+    for (int it = 0; it < iterations; it++)
+    {
+        char *p = out;
+        for (int i = 0; i < BENCH_VALUES; i++)
+            p = append_fixed(p, values[i], 16, 4);
+    }
+    double t12 = bench_seconds();
+    for (int it = 0; it < iterations; it++)
+    {
+        char *p = out;
+        for (int i = 0; i < BENCH_VALUES; i++)
+            p += snprintf(p, 24, "%.4f", (double)values[i] / 65536.0);
+    }
+    double t13 = bench_seconds();
+    for (int it = 0; it < iterations; it++)
+    {
+        char *p = out;
+        for (int i = 0; i < BENCH_VALUES; i++)
+            p = append_float(p, fvalues[i]);
+    }
+    double t14 = bench_seconds();
+    for (int it = 0; it < iterations; it++)
+    {
+        char *p = out;
+        for (int i = 0; i < BENCH_VALUES; i++)
+            p += snprintf(p, 24, "%.9g", (double)fvalues[i]); ///< Digits needed to round trip
+    }
+    double t15 = bench_seconds();
+
+    const double calls = (double)BENCH_VALUES * iterations;
+    printf("%zu chars per pass\n", chars);
+    printf("append_digit (subtract) : %6.2f ns/call\n", (t1 - t0) * 1e9 / calls);
+    printf("append_uint32           : %6.2f ns/call\n", (t2 - t1) * 1e9 / calls);
+    printf("snprintf                : %6.2f ns/call\n", (t3 - t2) * 1e9 / calls);
+    printf("MINSTR_FMT log line     : %6.2f ns/call\n", (t4 - t3) * 1e9 / calls);
+    printf("snprintf log line       : %6.2f ns/call (%zu)\n", (t5 - t4) * 1e9 / calls, line_chars);
+    const double hex_mb = (double)sizeof(values) * iterations / 1e6;
+    printf("append_hex loop         : %6.0f MB/s\n", hex_mb / (t6 - t5));
+    printf("append_hex_block        : %6.0f MB/s\n", hex_mb / (t7 - t6));
+    printf("parse_hex_block         : %6.0f MB/s (hex in)\n", 2 * hex_mb / (t8 - t7));
+    printf("sscanf %%2x              : %6.0f MB/s (hex in)\n", 2 * hex_mb / 10 / (t9 - t8));
+    printf("parse_uint32            : %6.2f ns/call\n", (t10 - t9) * 1e9 / calls);
+    printf("strtoul                 : %6.2f ns/call (%llu)\n", (t11 - t10) * 1e9 / calls, (unsigned long long)checksum);
+    printf("append_fixed Q16.16     : %6.2f ns/call\n", (t12 - t11) * 1e9 / calls);
+    printf("snprintf %%.4f           : %6.2f ns/call\n", (t13 - t12) * 1e9 / calls);
+    printf("append_float            : %6.2f ns/call\n", (t14 - t13) * 1e9 / calls);
+    printf("snprintf %%.9g           : %6.2f ns/call\n", (t15 - t14) * 1e9 / calls);
+    return 0;
+}
+#endif //BENCH